@@ -33,6 +33,7 @@
 
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
+#include "backends/fs/posix/posix-mmapstream.h"
 #include "common/algorithm.h"
 
 #include <sys/param.h>
@@ -276,6 +277,11 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+#ifdef HAS_MMAP
+	Common::SeekableReadStream *stream = PosixMmapStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
+#endif
 	return PosixIoStream::makeFromPath(getPath(), StdioStream::WriteMode_Read);
 }
 
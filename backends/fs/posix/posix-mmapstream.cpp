@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/posix/posix-mmapstream.h"
+
+#ifdef HAS_MMAP
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+uint32 PosixMmapStream::_threshold = 0;
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path) {
+	if (_threshold == 0)
+		return nullptr;
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) ||
+			(uint64)st.st_size < _threshold || (uint64)st.st_size > 0x7FFFFFFFULL) {
+		close(fd);
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMmapStream((const byte *)data, (uint32)st.st_size);
+}
+
+PosixMmapStream::PosixMmapStream(const byte *data, uint32 size) :
+		_data(data), _size(size), _pos(0), _eos(false) {
+}
+
+PosixMmapStream::~PosixMmapStream() {
+	munmap(const_cast<byte *>(_data), _size);
+}
+
+bool PosixMmapStream::seek(int64 offs, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offs += _size;
+		break;
+	case SEEK_CUR:
+		offs += _pos;
+		break;
+	case SEEK_SET:
+	default:
+		break;
+	}
+
+	if (offs < 0 || offs > _size)
+		return false;
+
+	_pos = (uint32)offs;
+	_eos = false;
+	return true;
+}
+
+uint32 PosixMmapStream::read(void *dataPtr, uint32 dataSize) {
+	if (dataSize > _size - _pos) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+
+	memcpy(dataPtr, _data + _pos, dataSize);
+	_pos += dataSize;
+	return dataSize;
+}
+
+const byte *PosixMmapStream::getContiguousData(int64 offset, uint32 size) const {
+	if (offset < 0 || offset > _size || size > _size - offset)
+		return nullptr;
+	return _data + offset;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_FS_POSIX_POSIXMMAPSTREAM_H
+#define BACKENDS_FS_POSIX_POSIXMMAPSTREAM_H
+
+#include "common/scummsys.h"
+
+#ifdef HAS_MMAP
+
+#include "common/noncopyable.h"
+#include "common/stream.h"
+#include "common/str.h"
+
+/**
+ * A read-only file stream backed by a memory mapping of the whole file.
+ *
+ * Reads are plain copies out of the mapping, and getContiguousData() gives
+ * direct access to the file contents for callers which would otherwise read
+ * them into a buffer of their own.
+ *
+ * Mapping is opt-in: a read error, or the file being truncated while it is
+ * mapped, raises SIGBUS instead of setting err(), and large files use up
+ * address space on 32-bit systems.
+ */
+class PosixMmapStream final : public Common::SeekableReadStream, public Common::NonCopyable {
+public:
+	/**
+	 * Map the file at the given path.
+	 *
+	 * Returns nullptr if the file can't be opened or mapped, or if it is
+	 * smaller than the threshold set with setThreshold(). The caller is then
+	 * expected to fall back to a regular stdio stream.
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path);
+
+	/**
+	 * Set the size in bytes from which files are mapped. The default, 0,
+	 * disables mapping altogether.
+	 */
+	static void setThreshold(uint32 threshold) { _threshold = threshold; }
+
+	~PosixMmapStream() override;
+
+	bool err() const override { return false; }
+	void clearErr() override { _eos = false; }
+	bool eos() const override { return _eos; }
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+	bool seek(int64 offs, int whence = SEEK_SET) override;
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+	const byte *getContiguousData(int64 offset, uint32 size) const override;
+
+private:
+	PosixMmapStream(const byte *data, uint32 size);
+
+	static uint32 _threshold;
+
+	const byte *_data;
+	uint32 _size;
+	uint32 _pos;
+	bool _eos;
+};
+
+#endif
+
+#endif
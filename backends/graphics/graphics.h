@@ -87,6 +87,7 @@ public:
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 	virtual Graphics::Surface *lockScreen() = 0;
 	virtual void unlockScreen() = 0;
+	virtual void unlockScreenRect(const Common::Rect &dirtyRect) { unlockScreen(); }
 	virtual void fillScreen(uint32 col) = 0;
 	virtual void fillScreen(const Common::Rect &r, uint32 col) = 0;
 	virtual void updateScreen() = 0;
@@ -814,6 +814,11 @@ void OpenGLGraphicsManager::unlockScreen() {
 	_gameScreen->flagDirty();
 }
 
+void OpenGLGraphicsManager::unlockScreenRect(const Common::Rect &dirtyRect) {
+	if (!dirtyRect.isEmpty())
+		_gameScreen->flagDirty(dirtyRect);
+}
+
 void OpenGLGraphicsManager::setFocusRectangle(const Common::Rect& rect) {
 }
 
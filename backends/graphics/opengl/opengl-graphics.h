@@ -109,6 +109,7 @@ public:
 
 	Graphics::Surface *lockScreen() override;
 	void unlockScreen() override;
+	void unlockScreenRect(const Common::Rect &dirtyRect) override;
 
 	void setFocusRectangle(const Common::Rect& rect) override;
 	void clearFocusRectangle() override;
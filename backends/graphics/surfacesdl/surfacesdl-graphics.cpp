@@ -1847,6 +1847,24 @@ void SurfaceSdlGraphicsManager::unlockScreen() {
 	_graphicsMutex.unlock();
 }
 
+void SurfaceSdlGraphicsManager::unlockScreenRect(const Common::Rect &dirtyRect) {
+	assert(_transactionMode == kTransactionNone);
+
+	// paranoia check
+	assert(_screenIsLocked);
+	_screenIsLocked = false;
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+
+	// Only update the changed area
+	if (!dirtyRect.isEmpty())
+		addDirtyRect(dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height(), false);
+
+	// Finally unlock the graphics mutex
+	_graphicsMutex.unlock();
+}
+
 void SurfaceSdlGraphicsManager::fillScreen(uint32 col) {
 	Graphics::Surface *screen = lockScreen();
 	if (screen)
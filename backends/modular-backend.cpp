@@ -181,6 +181,10 @@ void ModularGraphicsBackend::unlockScreen() {
 	_graphicsManager->unlockScreen();
 }
 
+void ModularGraphicsBackend::unlockScreenRect(const Common::Rect &dirtyRect) {
+	_graphicsManager->unlockScreenRect(dirtyRect);
+}
+
 void ModularGraphicsBackend::fillScreen(uint32 col) {
 	_graphicsManager->fillScreen(col);
 }
@@ -36,6 +36,7 @@
 #include "backends/saves/posix/posix-saves.h"
 #include "backends/fs/posix/posix-fs-factory.h"
 #include "backends/fs/posix/posix-fs.h"
+#include "backends/fs/posix/posix-mmapstream.h"
 #include "backends/taskbar/unity/unity-taskbar.h"
 #include "backends/dialogs/gtk/gtk-dialogs.h"
 
@@ -43,6 +44,7 @@
 #include "backends/audiocd/linux/linux-audiocd.h"
 #endif
 
+#include "common/config-manager.h"
 #include "common/textconsole.h"
 
 #include <stdlib.h>
@@ -88,6 +90,19 @@ void OSystem_POSIX::initBackend() {
 	_textToSpeechManager = new SpeechDispatcherManager();
 #endif
 
+#ifdef HAS_MMAP
+	// Files are only memory mapped when the user asks for it, see PosixMmapStream
+	if (ConfMan.hasKey("mmap_threshold")) {
+		const Common::String &value = ConfMan.get("mmap_threshold");
+		char *end;
+		long threshold = strtol(value.c_str(), &end, 10);
+		if (value.empty() || *end || threshold < 0 || threshold > 0x7FFFFFFFL)
+			warning("Ignoring invalid mmap_threshold value '%s'", value.c_str());
+		else
+			PosixMmapStream::setThreshold((uint32)threshold);
+	}
+#endif
+
 	// Invoke parent implementation of this method
 	OSystem_SDL::initBackend();
 
@@ -278,6 +278,14 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 		}
 	}
 
+	// Read ahead in large game files, which helps with slow storage such as
+	// SD cards and network shares. The window is given in KB, and is
+	// limited to 64 MB so that it can't overflow.
+	if (ConfMan.hasKey("prefetch_window")) {
+		const uint32 windowKB = CLIP(ConfMan.getInt("prefetch_window"), 0, 64 * 1024);
+		SearchMan.setPrefetchWindow(windowKB * 1024);
+	}
+
 #ifdef USE_TRANSLATION
 	Common::String previousLanguage = TransMan.getCurrentLanguage();
 	if (ConfMan.hasKey("gui_use_game_language")
@@ -323,6 +331,10 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 	// Free up memory
 	metaEngine.deleteInstance(engine, game, meDescriptor);
 
+	Common::SearchSet::LookupStats lookupStats = SearchMan.getLookupStats();
+	debug(1, "SearchMan: %u file lookups, %u misses, %u answered from the miss cache",
+		lookupStats.lookups, lookupStats.misses, lookupStats.cachedMisses);
+
 	// Reset the file/directory mappings
 	SearchMan.clear();
 
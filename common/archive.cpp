@@ -20,6 +20,7 @@
  */
 
 #include "common/archive.h"
+#include "common/bufferedstream.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/system.h"
@@ -308,6 +309,26 @@ uint MemcachingCaseInsensitiveArchive::CacheKey_Hash::operator()(const CacheKey
 	return static_cast<uint>(x.path.hashIgnoreCase() * 1000003u) ^ static_cast<uint>(x.altStreamType);
 }
 
+namespace {
+
+// Locks the mutex of the lookup cache of a SearchSet, if it has one yet
+class MissCacheLock {
+public:
+	explicit MissCacheLock(Mutex *mutex) : _mutex(mutex) {
+		if (_mutex)
+			_mutex->lock();
+	}
+	~MissCacheLock() {
+		if (_mutex)
+			_mutex->unlock();
+	}
+
+private:
+	Mutex *_mutex;
+};
+
+} // End of anonymous namespace
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
@@ -332,6 +353,8 @@ SearchSet::ArchiveNodeList::const_iterator SearchSet::find(const String &name) c
 	order prevails.
 */
 void SearchSet::insert(const Node &node) {
+	invalidateLookupCache();
+
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_priority < node._priority)
@@ -428,6 +451,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateLookupCache();
 	}
 }
 
@@ -451,6 +475,10 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+
+	MissCacheLock lock(getMissCacheMutex());
+	_missCache.clear();
+	_stats.lookups = _stats.misses = _stats.cachedMisses = 0;
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -469,10 +497,46 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
-bool SearchSet::hasFile(const Path &path) const {
-	if (path.empty())
+void SearchSet::invalidateLookupCache() {
+	MissCacheLock lock(getMissCacheMutex());
+	_missCache.clear();
+}
+
+SearchSet::LookupStats SearchSet::getLookupStats() const {
+	MissCacheLock lock(getMissCacheMutex());
+	return _stats;
+}
+
+Mutex *SearchSet::getMissCacheMutex() const {
+	// Without a backend there are no other threads to guard against
+	if (!_missCacheMutex && g_system)
+		_missCacheMutex = new Mutex();
+	return _missCacheMutex;
+}
+
+bool SearchSet::isCachedMiss(const Path &path) const {
+	MissCacheLock lock(getMissCacheMutex());
+	_stats.lookups++;
+	if (!_missCache.contains(path))
 		return false;
 
+	_stats.misses++;
+	_stats.cachedMisses++;
+	return true;
+}
+
+void SearchSet::addCachedMiss(const Path &path) const {
+	MissCacheLock lock(getMissCacheMutex());
+	_stats.misses++;
+
+	// Keep the cache from growing without bounds when many different
+	// paths are probed
+	if (_missCache.size() >= kMaxCachedMisses)
+		_missCache.clear();
+	_missCache[path] = true;
+}
+
+bool SearchSet::hasFileUncached(const Path &path) const {
 	for (const auto &archive : _list) {
 		if (archive._arc->hasFile(path))
 			return true;
@@ -481,6 +545,20 @@ bool SearchSet::hasFile(const Path &path) const {
 	return false;
 }
 
+bool SearchSet::hasFile(const Path &path) const {
+	if (path.empty())
+		return false;
+
+	if (isCachedMiss(path))
+		return false;
+
+	if (hasFileUncached(path))
+		return true;
+
+	addCachedMiss(path);
+	return false;
+}
+
 bool SearchSet::isPathDirectory(const Path &path) const {
 	if (path.empty())
 		return false;
@@ -553,6 +631,9 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	if (isCachedMiss(path))
+		return ArchiveMemberPtr();
+
 	for (const auto &archive : _list) {
 		if (archive._arc->hasFile(path)) {
 			if (container) {
@@ -562,6 +643,7 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 		}
 	}
 
+	addCachedMiss(path);
 	return ArchiveMemberPtr();
 }
 
@@ -573,12 +655,23 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	if (isCachedMiss(path))
+		return nullptr;
+
 	for (const auto &archive : _list) {
 		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
-		if (stream)
+		if (stream) {
+			// Streams which already are in memory gain nothing from reading ahead
+			if (_prefetchWindow && stream->size() > _prefetchWindow && !stream->getContiguousData(0, 1))
+				stream = wrapPrefetchingReadStream(stream, _prefetchWindow, DisposeAfterUse::YES);
 			return stream;
+		}
 	}
 
+	// Only remember the path as missing if the archives agree, and not
+	// because a file could not be opened
+	if (!hasFileUncached(path))
+		addCachedMiss(path);
 	return nullptr;
 }
 
@@ -620,6 +713,7 @@ SearchManager::SearchManager() {
 
 void SearchManager::clear() {
 	SearchSet::clear();
+	setPrefetchWindow(0);
 
 	// Always keep system specific archives in the SearchManager.
 	// But we give them a lower priority than the default priority (which is 0),
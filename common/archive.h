@@ -26,6 +26,8 @@
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 #include "common/list.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -328,7 +330,7 @@ private:
  * match. SearchSet does guarantee that searches are performed in DESCENDING
  * priority order. In case of conflicting priorities, insertion order prevails.
  */
-class SearchSet : public Archive {
+class SearchSet : public Archive, public NonCopyable {
 	struct Node {
 		int		_priority;
 		String	_name;
@@ -347,10 +349,47 @@ class SearchSet : public Archive {
 	void insert(const Node& node); //!< Add an archive while keeping the list sorted by descending priority.
 
 	bool _ignoreClashes;
+	uint32 _prefetchWindow;
 
 public:
-	SearchSet() : _ignoreClashes(false) { }
-	virtual ~SearchSet() { clear(); }
+	/** Statistics about the lookups of files in a SearchSet. */
+	struct LookupStats {
+		uint32 lookups;      ///< Number of lookups of files by path
+		uint32 misses;       ///< Number of lookups which found no file
+		uint32 cachedMisses; ///< Number of misses answered from the cache, without asking the archives
+	};
+
+private:
+	enum {
+		kMaxCachedMisses = 4096
+	};
+
+	/**
+	 * Paths which none of the archives contain. Archives such as FSDirectory
+	 * cache their listings anyway, so this only saves asking each archive
+	 * again, which adds up for sets with many archives.
+	 *
+	 * Lookups are const but update the cache and the statistics, so both
+	 * are guarded by _missCacheMutex to let several threads look up files
+	 * in the same set, e.g. SearchMan. The mutex is created once g_system
+	 * is available, so that sets can be created before the backend.
+	 */
+	typedef HashMap<Path, bool, Path::Hash, Path::EqualTo> MissCache;
+	mutable MissCache _missCache;
+	mutable LookupStats _stats;
+	mutable Mutex *_missCacheMutex;
+
+	Mutex *getMissCacheMutex() const;
+
+	bool isCachedMiss(const Path &path) const;
+	void addCachedMiss(const Path &path) const;
+	bool hasFileUncached(const Path &path) const;
+
+public:
+	SearchSet() : _ignoreClashes(false), _prefetchWindow(0), _missCacheMutex(nullptr) {
+		_stats.lookups = _stats.misses = _stats.cachedMisses = 0;
+	}
+	virtual ~SearchSet() { clear(); delete _missCacheMutex; }
 
 	char getPathSeparator() const override { return '/'; }
 
@@ -444,6 +483,24 @@ public:
 	 */
 	void setPriority(const String& name, int priority);
 
+	/**
+	 * Make streams opened through createReadStreamForMember() read ahead in
+	 * chunks of @p windowSize bytes, see wrapPrefetchingReadStream(). This
+	 * only applies to streams larger than the window which are not already
+	 * in memory. 0 disables reading ahead, which is the default.
+	 */
+	void setPrefetchWindow(uint32 windowSize) { _prefetchWindow = windowSize; }
+
+	/**
+	 * Forget which files were found to be missing. This is done automatically
+	 * when archives are added or removed, but must be called by code which
+	 * changes the contents of an archive in the set.
+	 */
+	void invalidateLookupCache();
+
+	/** Return statistics about the lookups of files in this set. */
+	LookupStats getLookupStats() const;
+
 	bool hasFile(const Path &path) const override;
 	bool isPathDirectory(const Path &path) const override;
 	int listMatchingMembers(ArchiveMemberList &list, const Path &pattern, bool matchPathComponents = false) const override;
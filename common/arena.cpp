@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Common {
+
+Arena::Arena(size_t blockSize) : _blockSize(blockSize), _curBlock(0), _curOffset(0) {
+	assert(blockSize > 0);
+}
+
+Arena::~Arena() {
+	freeBlocks();
+}
+
+void *Arena::allocateSlow(size_t size, size_t alignment) {
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	// The current block is full, so try the blocks kept from before the
+	// last rewind. Blocks which are too small are skipped until then.
+	uint b = _curBlock < _blocks.size() ? _curBlock + 1 : _curBlock;
+	for (; b < _blocks.size(); ++b) {
+		const size_t offset = alignOffset(_blocks[b].data, 0, alignment);
+		if (offset + size <= _blocks[b].size)
+			break;
+	}
+
+	if (b == _blocks.size()) {
+		Block block;
+		block.size = MAX(_blockSize, size + alignment - 1);
+		block.data = (byte *)malloc(block.size);
+		if (!block.data)
+			::error("Common::Arena: failure to allocate %u bytes", (uint)block.size);
+		_blocks.push_back(block);
+	}
+
+	const size_t offset = alignOffset(_blocks[b].data, 0, alignment);
+	_curBlock = b;
+	_curOffset = offset + size;
+	return _blocks[b].data + offset;
+}
+
+void Arena::rewind(const Mark &mark) {
+	assert(mark.block < _curBlock || (mark.block == _curBlock && mark.offset <= _curOffset));
+
+#ifndef RELEASE_BUILD
+	for (uint b = mark.block; b <= _curBlock && b < _blocks.size(); ++b) {
+		const size_t start = (b == mark.block) ? mark.offset : 0;
+		const size_t end = (b == _curBlock) ? _curOffset : _blocks[b].size;
+		memset(_blocks[b].data + start, kPoisonByte, end - start);
+	}
+#endif
+
+	_curBlock = mark.block;
+	_curOffset = mark.offset;
+}
+
+void Arena::freeBlocks() {
+	for (uint b = 0; b < _blocks.size(); ++b)
+		free(_blocks[b].data);
+
+	_blocks.clear();
+	_curBlock = 0;
+	_curOffset = 0;
+}
+
+size_t Arena::getBytesUsed() const {
+	size_t used = _curOffset;
+	for (uint b = 0; b < _curBlock && b < _blocks.size(); ++b)
+		used += _blocks[b].size;
+	return used;
+}
+
+size_t Arena::getBytesReserved() const {
+	size_t reserved = 0;
+	for (uint b = 0; b < _blocks.size(); ++b)
+		reserved += _blocks[b].size;
+	return reserved;
+}
+
+} // End of namespace Common
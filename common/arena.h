@@ -0,0 +1,179 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_arena Arena
+ * @ingroup common_memory
+ *
+ * @brief API for allocating short-lived memory from an arena.
+ * @{
+ */
+
+/**
+ * An arena hands out memory by advancing a pointer through large blocks,
+ * and releases everything allocated since a given point at once. This makes
+ * it a good fit for the many small objects that only live for one frame or
+ * one room, which would otherwise each go through malloc and free.
+ *
+ * Individual allocations cannot be freed, and the arena never calls
+ * destructors. Objects created in it must either be trivially destructible
+ * or be destroyed explicitly before the arena is rewound.
+ *
+ * The blocks are kept when the arena is rewound, so an arena that is reset
+ * every frame stops allocating memory once it has grown to the peak size of
+ * a frame. In non-release builds, released memory is overwritten with
+ * kPoisonByte to make use-after-rewind bugs show up early.
+ */
+class Arena : NonCopyable {
+public:
+	/** A position in the arena, which it can be rewound to. */
+	struct Mark {
+		uint block;
+		size_t offset;
+	};
+
+	enum {
+		kDefaultBlockSize = 16384,
+		/** Alignment suitable for any scalar type we use */
+		kDefaultAlignment = 8,
+		kPoisonByte = 0xDD
+	};
+
+	/**
+	 * Constructor for an arena.
+	 * @param blockSize		the size of the blocks allocated from the system;
+	 *						larger requests get a block of their own
+	 */
+	explicit Arena(size_t blockSize = kDefaultBlockSize);
+	~Arena();
+
+	/**
+	 * Allocate @p size bytes, aligned to @p alignment, which must be a
+	 * power of two. The memory is not initialized.
+	 */
+	void *allocate(size_t size, size_t alignment = kDefaultAlignment) {
+		if (_curBlock < _blocks.size()) {
+			const Block &block = _blocks[_curBlock];
+			const size_t offset = alignOffset(block.data, _curOffset, alignment);
+			if (offset + size <= block.size) {
+				_curOffset = offset + size;
+				return block.data + offset;
+			}
+		}
+		return allocateSlow(size, alignment);
+	}
+
+	/** Allocate uninitialized storage for @p count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T), alignof(T));
+	}
+
+	/** Return the current position, to be passed to rewind(). */
+	Mark getMark() const {
+		Mark mark = { _curBlock, _curOffset };
+		return mark;
+	}
+
+	/**
+	 * Release everything allocated since @p mark was taken. Marks taken
+	 * after @p mark become invalid.
+	 */
+	void rewind(const Mark &mark);
+
+	/** Release all allocations, but keep the blocks for reuse. */
+	void reset() {
+		Mark start = { 0, 0 };
+		rewind(start);
+	}
+
+	/** Release all allocations and return the blocks to the system. */
+	void freeBlocks();
+
+	/** Return the number of bytes allocated since the last reset, including padding. */
+	size_t getBytesUsed() const;
+
+	/** Return the number of bytes held in blocks. */
+	size_t getBytesReserved() const;
+
+private:
+	struct Block {
+		byte *data;
+		size_t size;
+	};
+
+	const size_t _blockSize;
+	Array<Block> _blocks;
+	uint _curBlock;
+	size_t _curOffset;
+
+	/** Return the first offset from @p offset on that is suitably aligned within the block at @p data. */
+	static size_t alignOffset(const byte *data, size_t offset, size_t alignment) {
+		const uintptr address = (uintptr)(data + offset);
+		return offset + (((address + alignment - 1) & ~(uintptr)(alignment - 1)) - address);
+	}
+
+	void *allocateSlow(size_t size, size_t alignment);
+};
+
+/**
+ * Rewinds an arena to the position it had when this object was created,
+ * once it goes out of scope.
+ */
+class ScopedArenaMark : NonCopyable {
+public:
+	explicit ScopedArenaMark(Arena &arena) : _arena(arena), _mark(arena.getMark()) {}
+	~ScopedArenaMark() { _arena.rewind(_mark); }
+
+private:
+	Arena &_arena;
+	const Arena::Mark _mark;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+/**
+ * A custom placement new operator, allocating the object from an Arena.
+ *
+ * The object is never destroyed by the arena, see Common::Arena. Use
+ * Arena::allocateArray() for arrays.
+ */
+inline void *operator new(size_t nbytes, Common::Arena &arena) {
+	return arena.allocate(nbytes);
+}
+
+inline void operator delete(void *p, Common::Arena &arena) {
+	// Only called if a constructor throws; the memory is released when the
+	// arena is rewound.
+}
+
+#endif
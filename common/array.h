@@ -618,6 +618,302 @@ private:
 	Comparator _comparator;
 };
 
+/**
+ * An array which keeps up to @p N elements inside the object itself, and
+ * only allocates memory once it grows beyond that. This avoids the heap
+ * for the many small arrays which are built and thrown away on hot paths
+ * (e.g. dirty rectangle lists), and it has a subset of the interface of
+ * Array.
+ *
+ * Growing past the inline storage moves the elements instead of copying
+ * them. Note that, unlike with Array, moving a SmallArray which uses its
+ * inline storage moves the elements one by one.
+ */
+template<class T, uint N>
+class SmallArray {
+public:
+	typedef T *iterator; /*!< Array iterator. */
+	typedef const T *const_iterator; /*!< Const-qualified array iterator. */
+
+	typedef T value_type; /*!< Value type of the array. */
+
+	typedef uint size_type; /*!< Size type of the array. */
+
+private:
+	static_assert(N > 0, "SmallArray needs at least one inline element");
+
+	size_type _capacity; /*!< Maximum number of elements the current storage can hold. */
+	size_type _size; /*!< How many elements the array holds. */
+	T *_storage; /*!< Either _inlineStorage, or memory allocated with malloc. */
+	alignas(T) byte _inlineStorage[N * sizeof(T)];
+
+public:
+	SmallArray() : _capacity(N), _size(0), _storage((T *)_inlineStorage) {}
+
+	/**
+	 * Construct an array as a copy of the given @p array.
+	 */
+	SmallArray(const SmallArray &array) : _capacity(N), _size(0), _storage((T *)_inlineStorage) {
+		reserve(array._size);
+		uninitialized_copy(array._storage, array._storage + array._size, _storage);
+		_size = array._size;
+	}
+
+	/**
+	 * Construct an array as a copy of the given array using the C++11 move semantic.
+	 */
+	SmallArray(SmallArray &&old) : _capacity(N), _size(0), _storage((T *)_inlineStorage) {
+		takeFrom(old);
+	}
+
+	/**
+	 * Construct an array using list initialization.
+	 */
+	SmallArray(std::initializer_list<T> list) : _capacity(N), _size(0), _storage((T *)_inlineStorage) {
+		reserve(list.size());
+		uninitialized_copy(list.begin(), list.end(), _storage);
+		_size = list.size();
+	}
+
+	~SmallArray() {
+		freeStorage();
+	}
+
+	/** Construct an element to the end of the array. */
+	template<class... TArgs>
+	void emplace_back(TArgs &&...args) {
+		if (_size == _capacity) {
+			// The parameters may refer to an element of this array, so
+			// construct the new element before moving the others
+			const size_type newCapacity = _capacity * 2;
+			T *newStorage = allocStorage(newCapacity);
+			new ((void *)(newStorage + _size)) T(Common::forward<TArgs>(args)...);
+			uninitialized_move(_storage, _storage + _size, newStorage);
+
+			freeStorage();
+			_storage = newStorage;
+			_capacity = newCapacity;
+		} else {
+			new ((void *)(_storage + _size)) T(Common::forward<TArgs>(args)...);
+		}
+
+		_size++;
+	}
+
+	/** Append an element to the end of the array. */
+	void push_back(const T &element) {
+		emplace_back(element);
+	}
+
+	/** Append an element to the end of the array. */
+	void push_back(T &&element) {
+		emplace_back(Common::move(element));
+	}
+
+	/** Remove the last element of the array. */
+	void pop_back() {
+		assert(_size > 0);
+		_size--;
+		_storage[_size].~T();
+	}
+
+	/** Insert an element into the array at the given position. */
+	void insert_at(size_type idx, const T &element) {
+		assert(idx <= _size);
+		emplace_back(element);
+		T tmp = Common::move(_storage[_size - 1]);
+		move_backward(_storage + idx, _storage + _size - 1, _storage + _size);
+		_storage[idx] = Common::move(tmp);
+	}
+
+	/** Remove an element at the given position from the array and return the value of that element. */
+	T remove_at(size_type idx) {
+		assert(idx < _size);
+		T tmp = Common::move(_storage[idx]);
+		move(_storage + idx + 1, _storage + _size, _storage + idx);
+		pop_back();
+		return tmp;
+	}
+
+	/** Erase the element at @p pos position and return an iterator pointing to the next element in the array. */
+	iterator erase(iterator pos) {
+		move(pos + 1, _storage + _size, pos);
+		pop_back();
+		return pos;
+	}
+
+	/** Return a pointer to the underlying memory serving as element storage. */
+	const T *data() const { return _storage; }
+	/** Return a pointer to the underlying memory serving as element storage. */
+	T *data() { return _storage; }
+
+	/** Return a reference to the first element of the array. */
+	T &front() {
+		assert(_size > 0);
+		return _storage[0];
+	}
+
+	/** Return a reference to the first element of the array. */
+	const T &front() const {
+		assert(_size > 0);
+		return _storage[0];
+	}
+
+	/** Return a reference to the last element of the array. */
+	T &back() {
+		assert(_size > 0);
+		return _storage[_size - 1];
+	}
+
+	/** Return a reference to the last element of the array. */
+	const T &back() const {
+		assert(_size > 0);
+		return _storage[_size - 1];
+	}
+
+	/** Return a reference to the element at the given position in the array. */
+	T &operator[](size_type idx) {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	/** Return a const reference to the element at the given position in the array. */
+	const T &operator[](size_type idx) const {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	/** Assign the given @p array to this array. */
+	SmallArray &operator=(const SmallArray &array) {
+		if (this == &array)
+			return *this;
+
+		clear();
+		reserve(array._size);
+		uninitialized_copy(array._storage, array._storage + array._size, _storage);
+		_size = array._size;
+
+		return *this;
+	}
+
+	/** Assign the given array to this array using the C++11 move semantic. */
+	SmallArray &operator=(SmallArray &&old) {
+		if (this == &old)
+			return *this;
+
+		clear();
+		takeFrom(old);
+
+		return *this;
+	}
+
+	/** Return the size of the array. */
+	size_type size() const {
+		return _size;
+	}
+
+	/** Check whether the array is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+
+	/** Return true if the elements are kept inside the object rather than on the heap. */
+	bool isInline() const {
+		return _storage == (const T *)_inlineStorage;
+	}
+
+	/** Clear the array of all its elements, and go back to the inline storage. */
+	void clear() {
+		freeStorage();
+		_storage = (T *)_inlineStorage;
+		_capacity = N;
+		_size = 0;
+	}
+
+	/** Check whether two arrays are identical. */
+	bool operator==(const SmallArray &other) const {
+		if (_size != other._size)
+			return false;
+		for (size_type i = 0; i < _size; ++i) {
+			if (_storage[i] != other._storage[i])
+				return false;
+		}
+		return true;
+	}
+
+	/** Check if two arrays are different. */
+	bool operator!=(const SmallArray &other) const {
+		return !(*this == other);
+	}
+
+	/** Return an iterator pointing to the first element in the array. */
+	iterator       begin() { return _storage; }
+	/** Return an iterator pointing past the last element in the array. */
+	iterator       end() { return _storage + _size; }
+	/** Return a const iterator pointing to the first element in the array. */
+	const_iterator begin() const { return _storage; }
+	/** Return a const iterator pointing past the last element in the array. */
+	const_iterator end() const { return _storage + _size; }
+
+	/** Reserve enough memory in the array so that it can store at least the given number of elements. */
+	void reserve(size_type newCapacity) {
+		if (newCapacity <= _capacity)
+			return;
+
+		T *newStorage = allocStorage(newCapacity);
+		uninitialized_move(_storage, _storage + _size, newStorage);
+
+		freeStorage();
+		_storage = newStorage;
+		_capacity = newCapacity;
+	}
+
+	/** Change the size of the array. */
+	void resize(size_type newSize) {
+		reserve(newSize);
+
+		for (size_type i = newSize; i < _size; ++i)
+			_storage[i].~T();
+		for (size_type i = _size; i < newSize; ++i)
+			new ((void *)&_storage[i]) T();
+
+		_size = newSize;
+	}
+
+private:
+	static T *allocStorage(size_type capacity) {
+		T *storage = (T *)malloc(sizeof(T) * capacity);
+		if (!storage)
+			::error("Common::SmallArray: failure to allocate %u bytes", capacity * (size_type)sizeof(T));
+		return storage;
+	}
+
+	/** Destroy the elements and release the storage, if it is on the heap. */
+	void freeStorage() {
+		for (size_type i = 0; i < _size; ++i)
+			_storage[i].~T();
+		if (!isInline())
+			free(_storage);
+	}
+
+	/** Move the content of @p old, which is left empty, into this empty array. */
+	void takeFrom(SmallArray &old) {
+		if (old.isInline()) {
+			uninitialized_move(old._storage, old._storage + old._size, _storage);
+			_size = old._size;
+			old.clear();
+		} else {
+			_storage = old._storage;
+			_capacity = old._capacity;
+			_size = old._size;
+
+			old._storage = (T *)old._inlineStorage;
+			old._capacity = N;
+			old._size = 0;
+		}
+	}
+};
+
 /** @} */
 
 } // End of namespace Common
@@ -66,6 +66,24 @@ ReadStream *wrapBufferedReadStream(ReadStream *parentStream, uint32 bufSize, Dis
  */
 SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream that
+ * reads ahead of the current position in chunks of up to @p windowSize
+ * bytes. Unlike the stream returned by wrapBufferedSeekableReadStream(),
+ * it keeps a part of the data before the current position when reading
+ * ahead, and seeks are only passed on to the wrapped stream once data
+ * outside of the window is needed. This helps with many small reads and
+ * short seeks in large files on slow storage.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The SeekableReadStream to wrap in a custom stream.
+ * @param windowSize          Size of the read-ahead window.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+SeekableReadStream *wrapPrefetchingReadStream(SeekableReadStream *parentStream, uint32 windowSize, DisposeAfterUse::Flag disposeParentStream);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream that
  * transparently provides buffering.
@@ -141,6 +141,10 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped,
  * provides transparent on-the-fly decompression. Assumes the data it
  * retrieves from the wrapped stream is compressed with deflate algorithm.
  *
+ * When built with zlib, the stream keeps a copy of the decompressor state
+ * every megabyte of output, and seeks resume decompression from the
+ * closest one instead of from the start of the data.
+ *
  * It is safe to call this with a NULL parameter (in this case, NULL is
  * returned).
  *
@@ -95,6 +95,8 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -321,10 +323,21 @@ typedef struct {
 typedef Common::HashMap<Common::Path, cached_file_in_zip, Common::Path::IgnoreCase_Hash,
 	Common::Path::IgnoreCase_EqualTo> ZipHash;
 
+/* The zipfile stream. It is shared with the streams of large members, which
+   read from it directly, so that they stay valid after the archive is closed.
+*/
+struct ZipSharedStream {
+	ZipSharedStream(Common::SeekableReadStream *stream) : _stream(stream) {}
+
+	Common::ScopedPtr<Common::SeekableReadStream> _stream;
+	Common::Mutex _mutex;
+};
+
 /* unz_s contain internal information about the zipfile
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<ZipSharedStream> _sharedStream;	/* owner of _stream */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -458,6 +471,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 
 	int err = UNZ_OK;
 
+	us->_sharedStream = Common::SharedPtr<ZipSharedStream>(new ZipSharedStream(stream));
 	us->_stream = stream;
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
@@ -489,7 +503,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		err = UNZ_ERRNO;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -516,7 +529,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		err = UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -606,7 +618,6 @@ int unzClose(unzFile file) {
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -780,6 +791,9 @@ int unzGetCurrentFileInfo(unzFile file,
 												  char *szFileName, uLong fileNameBufferSize,
 												  void *extraField, uLong extraFieldBufferSize,
 												  char *szComment,  uLong commentBufferSize) {
+	if (file == nullptr)
+		return UNZ_PARAMERROR;
+	Common::StackLock lock(((unz_s *)file)->_sharedStream->_mutex);
 	return unzlocal_GetCurrentFileInfoInternal(file,pfile_info,nullptr,
 												szFileName,fileNameBufferSize,
 												extraField,extraFieldBufferSize,
@@ -958,6 +972,82 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
 	return err;
 }
 
+/*
+  Members bigger than this are not read into memory, but streamed from
+  the zipfile on demand.
+*/
+#define MAX_MEMCACHED_MEMBER_SIZE (1024 * 1024)
+
+/*
+  Read stream over the raw data of a member in the zipfile.
+*/
+class ZipMemberReadStream : public Common::SeekableReadStream {
+public:
+	ZipMemberReadStream(const Common::SharedPtr<ZipSharedStream> &sharedStream, uint32 begin, uint32 size) :
+		_sharedStream(sharedStream), _begin(begin), _size(size), _pos(0), _eos(false), _err(false) {}
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = false; _err = false; }
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		switch (whence) {
+		case SEEK_END:
+			offset += _size;
+			break;
+		case SEEK_CUR:
+			offset += _pos;
+			break;
+		case SEEK_SET:
+		default:
+			break;
+		}
+
+		if (offset < 0 || offset > _size)
+			return false;
+
+		_pos = (uint32)offset;
+		_eos = false;
+		return true;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		if (dataSize > _size - _pos) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+
+		// The zipfile stream is shared with the archive and the other
+		// member streams, which may be used from other threads.
+		Common::StackLock lock(_sharedStream->_mutex);
+		Common::SeekableReadStream *stream = _sharedStream->_stream.get();
+		stream->seek(_begin + _pos);
+		uint32 actualRead = stream->read(dataPtr, dataSize);
+		if (stream->err())
+			_err = true;
+		_pos += actualRead;
+		return actualRead;
+	}
+
+	const byte *getContiguousData(int64 offset, uint32 size) const override {
+		if (offset < 0 || offset > _size || size > _size - offset)
+			return nullptr;
+		// The zipfile stream outlives this stream, so this stays valid
+		return _sharedStream->_stream->getContiguousData(_begin + offset, size);
+	}
+
+private:
+	Common::SharedPtr<ZipSharedStream> _sharedStream;
+	uint32 _begin;
+	uint32 _size;
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+};
+
 /*
   Open for reading data the current file in the zipfile.
   If there is no error and the file is opened, the return value is UNZ_OK.
@@ -978,6 +1068,8 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	if (!s->current_file_ok)
 		return Common::SharedArchiveContents();
 
+	Common::StackLock lock(s->_sharedStream->_mutex);
+
 	if (unzlocal_CheckCurrentFileCoherencyHeader(s, &iSizeVar,
 				&offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
 		return Common::SharedArchiveContents();
@@ -988,9 +1080,21 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	}
 
 	uint32 crc32_wait = s->cur_file_info.crc;
+	uint32 dataStart = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar;
+
+	/* Large members are streamed instead of being decompressed into memory
+	   in one go. Their CRC can't be checked up front in that case. */
+	if (s->cur_file_info.uncompressed_size > MAX_MEMCACHED_MEMBER_SIZE) {
+		Common::SeekableReadStream *member = new ZipMemberReadStream(s->_sharedStream, dataStart, s->cur_file_info.compressed_size);
+		if (s->cur_file_info.compression_method == Z_DEFLATED)
+			member = Common::wrapDeflateReadStream(member, DisposeAfterUse::YES, s->cur_file_info.uncompressed_size);
+		if (!member)
+			return Common::SharedArchiveContents();
+		return Common::SharedArchiveContents::bypass(member);
+	}
 
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
-	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+	s->_stream->seek(dataStart);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
 	byte *uncompressedBuffer = nullptr;
 
@@ -33,6 +33,7 @@
 
 #include "common/compression/deflate.h"
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -95,7 +96,18 @@ static bool _shownBackwardSeekingWarning = false;
 class GZipReadStream : public SeekableReadStream {
 protected:
 	enum {
-		BUFSIZE = 16384		// 1 << MAX_WBITS
+		BUFSIZE = 16384,		// 1 << MAX_WBITS
+		RESTART_INTERVAL = 1024 * 1024
+	};
+
+	/**
+	 * A copy of the inflater state at some point of the output, from which
+	 * decompression can be resumed when seeking.
+	 */
+	struct RestartPoint {
+		uint32 pos;
+		uint64 parentPos;
+		z_stream stream;
 	};
 
 	byte	_buf[BUFSIZE];
@@ -108,6 +120,34 @@ protected:
 	uint32 _origSize;
 	bool _eos;
 
+	// Kept every RESTART_INTERVAL bytes of output, ordered by position
+	Array<RestartPoint *> _restartPoints;
+	uint32 _nextRestartPos;
+
+	void addRestartPoint() {
+		RestartPoint *point = new RestartPoint();
+		if (inflateCopy(&point->stream, &_stream) != Z_OK) {
+			delete point;
+			return;
+		}
+		point->pos = _pos;
+		// Input still in _buf is read again when resuming from here
+		point->parentPos = _wrapped->pos() - _stream.avail_in;
+		_restartPoints.push_back(point);
+	}
+
+	bool resumeFrom(const RestartPoint *point) {
+		inflateEnd(&_stream);
+		_zlibErr = inflateCopy(&_stream, const_cast<z_stream *>(&point->stream));
+		if (_zlibErr != Z_OK)
+			return false;
+		_wrapped->seek(point->parentPos, SEEK_SET);
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_pos = point->pos;
+		return true;
+	}
+
 public:
 
 	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize) : _wrapped(w, disposeParent), _stream() {
@@ -131,6 +171,7 @@ public:
 		w->seek(_parentPos, SEEK_SET);
 		_pos = 0;
 		_eos = false;
+		_nextRestartPos = RESTART_INTERVAL;
 
 		// Adding 32 to windowBits indicates to zlib that it is supposed to
 		// automatically detect whether gzip or zlib headers are used for
@@ -156,6 +197,7 @@ public:
 		_origSize = knownSize;
 		_pos = 0;
 		_eos = false;
+		_nextRestartPos = RESTART_INTERVAL;
 
 		_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
 		if (_zlibErr != Z_OK)
@@ -175,6 +217,10 @@ public:
 
 	~GZipReadStream() {
 		inflateEnd(&_stream);
+		for (uint i = 0; i < _restartPoints.size(); i++) {
+			inflateEnd(&_restartPoints[i]->stream);
+			delete _restartPoints[i];
+		}
 	}
 
 	bool err() const override { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
@@ -184,6 +230,11 @@ public:
 	}
 
 	uint32 read(void *dataPtr, uint32 dataSize) override {
+		if (_zlibErr == Z_OK && _pos >= _nextRestartPos) {
+			addRestartPoint();
+			_nextRestartPos = _pos + RESTART_INTERVAL;
+		}
+
 		_stream.next_out = (byte *)dataPtr;
 		_stream.avail_out = dataSize;
 
@@ -234,7 +285,16 @@ public:
 
 		assert(newPos >= 0);
 
-		if ((uint32)newPos < _pos) {
+		// Resume from the closest restart point before the new position,
+		// unless decompressing from the current position gets there sooner
+		const RestartPoint *point = nullptr;
+		for (uint i = 0; i < _restartPoints.size() && _restartPoints[i]->pos <= (uint32)newPos; i++)
+			point = _restartPoints[i];
+
+		if (point && ((uint32)newPos < _pos || point->pos > _pos)) {
+			if (!resumeFrom(point))
+				return false;
+		} else if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
 			// to avoid it. :/
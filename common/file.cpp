@@ -142,6 +142,11 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+const byte *File::getContiguousData(int64 offset, uint32 size) const {
+	assert(_handle);
+	return _handle->getContiguousData(offset, size);
+}
+
 
 DumpFile::DumpFile() : _handle(nullptr) {
 }
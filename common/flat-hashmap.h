@@ -0,0 +1,584 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The flat hash map in this file follows the design of the "Swiss table"
+// hash maps: a separate array of control bytes holds 7 bits of the hash
+// of each occupied slot, and is probed a group of 8 slots at a time.
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/endian.h"
+#include "common/hashmap.h"
+#include "common/intrinsics.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flat_hashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a flat hash table.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> maps objects of type Key to objects of type Val, and
+ * has the same interface as HashMap.
+ *
+ * Unlike HashMap, the keys and values are stored inline in one array instead
+ * of in separately allocated nodes, and lookups only compare keys whose
+ * stored hash bits match. This makes lookups cheaper, especially in maps with
+ * many entries, at the cost of one restriction: adding a key may move all
+ * entries, invalidating references to values and iterators. Only use it
+ * where such references are not kept across insertions.
+ *
+ * Erasing entries never moves other entries, so iterating over the map and
+ * erasing the current entry works like it does with HashMap.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(const Node &node) : _value(node._value), _key(node._key) {}
+		Node(Node &&node) : _value(Common::move(node._value)), _key(node._key) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+		FLATHASHMAP_GROUP_WIDTH = 8,
+
+		// The map grows when more than 7/8 of the slots are in use,
+		// counting erased entries
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	// Control byte values. Occupied slots store 7 bits of their hash instead.
+	enum {
+		kCtrlEmpty = 0x80,
+		kCtrlDeleted = 0xFE
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	/**
+	 * Control bytes, one per slot followed by a copy of the first group,
+	 * so a group can be read at any slot without wrapping around.
+	 */
+	byte *_ctrl;
+	Node *_storage;		///< Slots, of which only those marked occupied are constructed
+	size_type _mask;	///< Capacity of the map minus one; the capacity is a power of two
+	size_type _size;
+	size_type _deleted;	///< Number of slots marked as deleted
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	static const uint64 kLsbs = 0x0101010101010101ULL;
+	static const uint64 kMsbs = 0x8080808080808080ULL;
+
+	/**
+	 * Spread the bits of the hash, since many hash functions (e.g. for
+	 * integers) don't. This is the finalizer of MurmurHash3, after which
+	 * every bit depends on all bits of the input. Both the probe start
+	 * (low bits) and the control byte (high bits) are taken from it.
+	 */
+	static uint32 mixHash(uint32 hash) {
+		hash ^= hash >> 16;
+		hash *= 0x85EBCA6B;
+		hash ^= hash >> 13;
+		hash *= 0xC2B2AE35;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+	static byte hashCtrl(uint32 mixed) {
+		return mixed >> 25;
+	}
+
+	uint64 loadGroup(size_type idx) const {
+		return READ_LE_UINT64(_ctrl + idx);
+	}
+
+	/** Bit mask with the high bit set in each byte of the group equal to @p ctrl. */
+	static uint64 matchCtrl(uint64 group, byte ctrl) {
+		// This may report false positives above a real match, which
+		// are weeded out by the key comparison.
+		const uint64 x = group ^ (kLsbs * ctrl);
+		return (x - kLsbs) & ~x & kMsbs;
+	}
+
+	static uint64 matchEmpty(uint64 group) {
+		return group & ~(group << 6) & kMsbs;
+	}
+
+	static uint64 matchEmptyOrDeleted(uint64 group) {
+		return group & ~(group << 7) & kMsbs;
+	}
+
+	/** Index within the group of the lowest match in @p mask. */
+	static size_type lowestMatch(uint64 mask) {
+		const uint64 lowest = mask & (~mask + 1);
+		const uint32 low = (uint32)lowest;
+		return (low ? intLog2(low) : 32 + intLog2((uint32)(lowest >> 32))) >> 3;
+	}
+
+	void setCtrl(size_type idx, byte ctrl) {
+		_ctrl[idx] = ctrl;
+		if (idx < FLATHASHMAP_GROUP_WIDTH)
+			_ctrl[_mask + 1 + idx] = ctrl;
+	}
+
+	bool isOccupied(size_type idx) const {
+		return !(_ctrl[idx] & 0x80);
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type findInsertSlot(uint32 mixed) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isOccupied(_idx));
+			return &_hashmap->_storage[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !_hashmap->isOccupied(_idx));
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const {
+		return lookup(key) != (size_type)-1;
+	}
+
+	Val &operator[](const Key &key) { return getOrCreateVal(key); }
+	const Val &operator[](const Key &key) const { return getVal(key); }
+
+	Val &getOrCreateVal(const Key &key) {
+		// Adding the key may reallocate the storage, so look it up first
+		const size_type ctr = lookupAndCreateIfMissing(key);
+		return _storage[ctr]._value;
+	}
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+
+	const Val &getValOrDefault(const Key &key) const {
+		return getValOrDefault(key, _defaultVal);
+	}
+
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const {
+		size_type ctr = lookup(key);
+		return ctr != (size_type)-1 ? _storage[ctr]._value : defaultVal;
+	}
+
+	bool tryGetVal(const Key &key, Val &out) const {
+		size_type ctr = lookup(key);
+		if (ctr == (size_type)-1)
+			return false;
+		out = _storage[ctr]._value;
+		return true;
+	}
+
+	void setVal(const Key &key, const Val &val) {
+		const size_type ctr = lookupAndCreateIfMissing(key);
+		_storage[ctr]._value = val;
+	}
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isOccupied(ctr))
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isOccupied(ctr))
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating empty storage for @p capacity slots.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_size = 0;
+	_deleted = 0;
+
+	_ctrl = (byte *)malloc(capacity + FLATHASHMAP_GROUP_WIDTH);
+	_storage = (Node *)malloc(capacity * sizeof(Node));
+	if (!_ctrl || !_storage)
+		::error("Common::FlatHashMap: failure to allocate %u slots", capacity);
+	memset(_ctrl, kCtrlEmpty, capacity + FLATHASHMAP_GROUP_WIDTH);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isOccupied(ctr))
+			_storage[ctr].~Node();
+	}
+
+	free(_ctrl);
+	free(_storage);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// Clone the slots one by one, keeping their positions
+	memcpy(_ctrl, map._ctrl, _mask + 1 + FLATHASHMAP_GROUP_WIDTH);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isOccupied(ctr))
+			new ((void *)&_storage[ctr]) Node(map._storage[ctr]);
+	}
+
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+		return;
+	}
+
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isOccupied(ctr))
+			_storage[ctr].~Node();
+	}
+	memset(_ctrl, kCtrlEmpty, _mask + 1 + FLATHASHMAP_GROUP_WIDTH);
+
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Internal method for moving all entries to new storage of @p newCapacity
+ * slots, which also drops all deleted slots.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	const size_type old_mask = _mask;
+	const size_type old_size = _size;
+	byte *old_ctrl = _ctrl;
+	Node *old_storage = _storage;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		if (old_ctrl[ctr] & 0x80)
+			continue;
+
+		// Since we know that no key exists twice in the old table, we
+		// only need to find a free slot, without calling _equal().
+		const uint32 mixed = mixHash(_hash(old_storage[ctr]._key));
+		const size_type idx = findInsertSlot(mixed);
+		setCtrl(idx, hashCtrl(mixed));
+		new ((void *)&_storage[idx]) Node(Common::move(old_storage[ctr]));
+		old_storage[ctr].~Node();
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == old_size);
+	(void)old_size;
+
+	free(old_ctrl);
+	free(old_storage);
+}
+
+/**
+ * Internal method returning the slot of @p key, or (size_type)-1 if the key
+ * is not in the map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const uint32 mixed = mixHash(_hash(key));
+	const byte ctrl = hashCtrl(mixed);
+	size_type pos = mixed & _mask;
+
+	for (size_type step = FLATHASHMAP_GROUP_WIDTH; ; step += FLATHASHMAP_GROUP_WIDTH) {
+		const uint64 group = loadGroup(pos);
+
+		for (uint64 match = matchCtrl(group, ctrl); match; match &= match - 1) {
+			const size_type idx = (pos + lowestMatch(match)) & _mask;
+			if (_equal(_storage[idx]._key, key))
+				return idx;
+		}
+
+		// An empty slot ends the probe sequence of any key
+		if (matchEmpty(group))
+			return (size_type)-1;
+
+		pos = (pos + step) & _mask;
+	}
+}
+
+/**
+ * Internal method returning the first empty or deleted slot in the probe
+ * sequence of a key with the given mixed hash.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findInsertSlot(uint32 mixed) const {
+	size_type pos = mixed & _mask;
+
+	for (size_type step = FLATHASHMAP_GROUP_WIDTH; ; step += FLATHASHMAP_GROUP_WIDTH) {
+		const uint64 match = matchEmptyOrDeleted(loadGroup(pos));
+		if (match)
+			return (pos + lowestMatch(match)) & _mask;
+
+		pos = (pos + step) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return ctr;
+
+	// Keep the load factor below a certain threshold.
+	// Deleted slots are also counted, but if they make up most of the
+	// used slots, dropping them is enough.
+	const size_type capacity = _mask + 1;
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		rehash(_deleted > _size ? capacity : capacity * 2);
+
+	const uint32 mixed = mixHash(_hash(key));
+	ctr = findInsertSlot(mixed);
+	if (_ctrl[ctr] == kCtrlDeleted)
+		_deleted--;
+	setCtrl(ctr, hashCtrl(mixed));
+	new ((void *)&_storage[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _storage[ctr]._value;
+	else
+		// See the comment in HashMap::getVal()
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _storage[ctr]._value;
+	else
+		// See the comment in HashMap::getVal()
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(isOccupied(ctr));
+
+	// Mark the slot as deleted, so that probe sequences running through
+	// it continue past it.
+	_storage[ctr].~Node();
+	setCtrl(ctr, kCtrlDeleted);
+	_size--;
+	_deleted++;
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr == (size_type)-1)
+		return;
+
+	erase(iterator(ctr, this));
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
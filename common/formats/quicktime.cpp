@@ -27,6 +27,7 @@
 // Seek function by Gael Chardon gael.dev@4now.net
 //
 
+#include "common/algorithm.h"
 #include "common/debug.h"
 #include "common/endian.h"
 #include "common/macresman.h"
@@ -1276,6 +1277,50 @@ QuickTimeParser::Track::Track() {
 	targetTrack = 0;
 }
 
+void QuickTimeParser::Track::buildSampleIndex() {
+	if (!sampleIndex.empty())
+		return;
+
+	sampleIndex.reserve(frameCount);
+
+	uint32 sampleToChunkIndex = 0;
+	for (uint32 i = 0; i < chunkCount && sampleIndex.size() < frameCount; i++) {
+		if (sampleToChunkIndex < sampleToChunkCount && i >= sampleToChunk[sampleToChunkIndex].first)
+			sampleToChunkIndex++;
+
+		if (sampleToChunkIndex == 0)
+			continue;
+
+		const SampleToChunkEntry &entry = sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = chunkOffsets[i];
+
+		for (uint32 j = 0; j < entry.count && sampleIndex.size() < frameCount; j++) {
+			const uint32 sample = sampleIndex.size();
+			if (sampleSize == 0 && sample >= sampleCount)
+				return;
+
+			SampleLocation location;
+			location.offset = offset;
+			location.descId = entry.id;
+			sampleIndex.push_back(location);
+
+			offset += (sampleSize != 0) ? sampleSize : sampleSizes[sample];
+		}
+	}
+}
+
+uint32 QuickTimeParser::Track::findKeyFrame(uint32 frame) const {
+	// The sync sample table is sorted, so the last key frame at or before
+	// the frame can be found with a binary search
+	const uint32 *next = Common::upperBound(keyframes, keyframes + keyframeCount, frame);
+
+	// If none found, we'll assume the requested frame is a key frame
+	if (next == keyframes)
+		return frame;
+
+	return *(next - 1);
+}
+
 String QuickTimeParser::PanoStringTable::getString(int32 offset) const {
 	offset -= 8;
 
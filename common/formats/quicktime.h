@@ -120,6 +120,11 @@ protected:
 		uint32 id;
 	};
 
+	struct SampleLocation {
+		uint32 offset;
+		uint32 descId;
+	};
+
 	struct EditListEntry {
 		uint32 trackDuration; // movie time
 		uint32 timeOffset;    // movie time
@@ -312,6 +317,15 @@ public:
 		uint32 *keyframes;
 		int32 timeScale; // media time
 
+		/**
+		 * File offset and sample description of every sample, so samples can be
+		 * located without walking the chunk tables. Filled by buildSampleIndex().
+		 */
+		Common::Array<SampleLocation> sampleIndex;
+
+		void buildSampleIndex();
+		uint32 findKeyFrame(uint32 frame) const;
+
 		uint16 width;
 		uint16 height;
 		CodecType codecType;
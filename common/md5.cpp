@@ -244,37 +244,84 @@ void md5_finish(md5_context *ctx, uint8 digest[16]) {
 
 
 bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length) {
+	return computeStreamMD5s(stream, &length, 1, (uint8 (*)[16])digest);
+}
 
+bool computeStreamMD5s(ReadStream &stream, const uint32 *lengths, uint count, uint8 (*digests)[16]) {
 #ifdef DISABLE_MD5
-	memset(digest, 0, 16);
+	memset(digests, 0, count * 16);
 #else
 	md5_context ctx;
-	int i;
-	unsigned char buf[1000];
-	bool restricted = (length != 0);
-	uint32 readlen;
-
-	if (!restricted || sizeof(buf) <= length)
-		readlen = sizeof(buf);
-	else
-		readlen = length;
+	// A multiple of the block size, so that md5_update doesn't need to
+	// buffer partial blocks between reads
+	byte buf[4096];
+	uint32 pos = 0;
+
+	// If the data is in memory already, hash it in place
+	SeekableReadStream *seekable = dynamic_cast<SeekableReadStream *>(&stream);
+	const byte *data = nullptr;
+	uint32 dataLeft = 0;
+	int64 startPos = 0;
+	if (seekable) {
+		startPos = seekable->pos();
+		int64 left = seekable->size() - startPos;
+		if (startPos >= 0 && left > 0 && left <= 0xFFFFFFFF) {
+			data = seekable->getContiguousData(startPos, (uint32)left);
+			dataLeft = (uint32)left;
+		}
+	}
 
 	md5_starts(&ctx);
 
-	while ((i = stream.read(buf, readlen)) > 0) {
-		md5_update(&ctx, buf, i);
+	for (;;) {
+		// Find out how much to hash before the next checksum is due
+		bool whole = false;
+		uint32 readlen = 0;
+		for (uint i = 0; i < count; i++) {
+			if (lengths[i] == 0)
+				whole = true;
+			else if (lengths[i] > pos && (readlen == 0 || lengths[i] - pos < readlen))
+				readlen = lengths[i] - pos;
+		}
+
+		if (readlen == 0 && !whole)
+			break;
+
+		uint32 len;
+		if (data) {
+			len = (readlen == 0 || readlen > dataLeft) ? dataLeft : readlen;
+			md5_update(&ctx, data, len);
+			data += len;
+			dataLeft -= len;
+		} else {
+			if (readlen == 0 || readlen > sizeof(buf))
+				readlen = sizeof(buf);
+			len = stream.read(buf, readlen);
+			md5_update(&ctx, buf, len);
+		}
 
-		if (restricted) {
-			length -= i;
-			if (length == 0)
-				break;
+		if (len == 0)
+			break;
+		pos += len;
 
-			if (sizeof(buf) > length)
-				readlen = length;
+		for (uint i = 0; i < count; i++) {
+			if (lengths[i] == pos) {
+				md5_context prefixCtx = ctx;
+				md5_finish(&prefixCtx, digests[i]);
+			}
 		}
 	}
 
-	md5_finish(&ctx, digest);
+	// Whatever is left ends with the stream
+	for (uint i = 0; i < count; i++) {
+		if (lengths[i] == 0 || lengths[i] > pos) {
+			md5_context finalCtx = ctx;
+			md5_finish(&finalCtx, digests[i]);
+		}
+	}
+
+	if (data)
+		seekable->seek(startPos + pos);
 #endif
 	return true;
 }
@@ -291,4 +338,20 @@ String computeStreamMD5AsString(ReadStream &stream, uint32 length) {
 	return md5;
 }
 
+bool computeStreamMD5sAsString(ReadStream &stream, const uint32 *lengths, uint count, String *md5s) {
+	uint8 (*digests)[16] = new uint8[count][16];
+	bool result = computeStreamMD5s(stream, lengths, count, digests);
+	if (result) {
+		for (uint i = 0; i < count; i++) {
+			md5s[i].clear();
+			for (int j = 0; j < 16; j++) {
+				md5s[i] += String::format("%02x", (int)digests[i][j]);
+			}
+		}
+	}
+
+	delete[] digests;
+	return result;
+}
+
 } // End of namespace Common
@@ -62,6 +62,31 @@ bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length = 0);
  */
 String computeStreamMD5AsString(ReadStream &stream, uint32 length = 0);
 
+/**
+ * Compute several MD5 checksums of leading parts of the given ReadStream
+ * in a single pass over the data.
+ * This is equivalent to, but faster than, calling computeStreamMD5 for each
+ * length and rewinding the stream in between.
+ * @param[in] stream	the stream of whose data the MD5s are computed
+ * @param[in] lengths	the number of bytes for each checksum; 0 means all
+ * @param[in] count	the number of checksums to compute
+ * @param[out] digests	the computed MD5 checksums, in the order of lengths
+ * @return true on success, false if an error occurred
+ */
+bool computeStreamMD5s(ReadStream &stream, const uint32 *lengths, uint count, uint8 (*digests)[16]);
+
+/**
+ * Compute several MD5 checksums of leading parts of the given ReadStream
+ * in a single pass over the data, as human readable hex strings.
+ * @see computeStreamMD5s
+ * @param[in] stream	the stream of whose data the MD5s are computed
+ * @param[in] lengths	the number of bytes for each checksum; 0 means all
+ * @param[in] count	the number of checksums to compute
+ * @param[out] md5s	the computed MD5 checksums, in the order of lengths
+ * @return true on success, false if an error occurred
+ */
+bool computeStreamMD5sAsString(ReadStream &stream, const uint32 *lengths, uint count, String *md5s);
+
 /** @} */
 
 } // End of namespace Common
@@ -2,6 +2,7 @@ MODULE := common
 
 MODULE_OBJS := \
 	archive.o \
+	arena.o \
 	base64.o \
 	btea.o \
 	concatstream.o \
@@ -22,46 +22,32 @@
 #include "common/str-base.h"
 #include "common/hash-str.h"
 #include "common/list.h"
-#include "common/memorypool.h"
 #include "common/textconsole.h"
 #include "common/util.h"
-#include "common/mutex.h"
 
 namespace Common {
 
 #define TEMPLATE template<class T>
 #define BASESTRING BaseString<T>
 
-MemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
-#ifndef SCUMMVM_UTIL
-Mutex *g_refCountPoolMutex = nullptr;
-
-void lockMemoryPoolMutex() {
-	// The Mutex class can only be used once g_system is set and initialized,
-	// but we may use the String class earlier than that (it is for example
-	// used in the OSystem_POSIX constructor). However in those early stages
-	// we can hope we don't have multiple threads either.
-	if (!g_system || !g_system->backendInitialized())
-		return;
-	if (!g_refCountPoolMutex)
-		g_refCountPoolMutex = new Mutex();
-	g_refCountPoolMutex->lock();
-}
+// Heap storage is allocated in one block together with its reference count,
+// which is kept in front of the string data. This size keeps the string data
+// suitably aligned for all character types.
+static const uint32 kRefCountSize = 8;
 
-void unlockMemoryPoolMutex() {
-	if (g_refCountPoolMutex)
-		g_refCountPoolMutex->unlock();
+template<class T>
+static T *allocStorage(uint32 capacity, int *&refCount) {
+	byte *block = new byte[kRefCountSize + capacity * sizeof(T)];
+	assert(block);
+	refCount = (int *)block;
+	*refCount = 1;
+	return (T *)(block + kRefCountSize);
 }
 
-TEMPLATE void BASESTRING::releaseMemoryPoolMutex() {
-	if (g_refCountPoolMutex){
-		delete g_refCountPoolMutex;
-		g_refCountPoolMutex = nullptr;
-	}
+static void freeStorage(int *refCount) {
+	delete[] (byte *)refCount;
 }
 
-#endif
-
 static uint32 computeCapacity(uint32 len) {
 	// By default, for the capacity we use the next multiple of 32
 	return ((len + 32 - 1) & ~0x1F);
@@ -127,13 +113,14 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 	bool isShared;
 	uint32 curCapacity, newCapacity;
 	value_type *newStorage;
+	int *newRefCount = nullptr;
 	int *oldRefCount = _extern._refCount;
 
 	if (isStorageIntern()) {
 		isShared = false;
 		curCapacity = _builtinCapacity;
 	} else {
-		isShared = (oldRefCount && *oldRefCount > 1);
+		isShared = (*oldRefCount > 1);
 		curCapacity = _extern._capacity;
 	}
 
@@ -157,8 +144,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 			newCapacity = MAX(curCapacity * 2, computeCapacity(new_size + 1));
 
 		// Allocate new storage
-		newStorage = new value_type[newCapacity];
-		assert(newStorage);
+		newStorage = allocStorage<value_type>(newCapacity, newRefCount);
 	}
 
 	// Copy old data if needed, elsewise reset the new storage.
@@ -180,7 +166,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 		// Set the ref count & capacity if we use an external storage.
 		// It is important to do this *after* copying any old content,
 		// else we would override data that has not yet been copied!
-		_extern._refCount = nullptr;
+		_extern._refCount = newRefCount;
 		_extern._capacity = newCapacity;
 	}
 }
@@ -188,23 +174,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 TEMPLATE
 void BASESTRING::incRefCount() const {
 	assert(!isStorageIntern());
-	if (_extern._refCount == nullptr) {
-#ifndef SCUMMVM_UTIL
-		lockMemoryPoolMutex();
-#endif
-		if (g_refCountPool == nullptr) {
-			g_refCountPool = new MemoryPool(sizeof(int));
-			assert(g_refCountPool);
-		}
-
-		_extern._refCount = (int *)g_refCountPool->allocChunk();
-#ifndef SCUMMVM_UTIL
-		unlockMemoryPoolMutex();
-#endif
-		*_extern._refCount = 2;
-	} else {
-		++(*_extern._refCount);
-	}
+	++(*_extern._refCount);
 }
 
 TEMPLATE
@@ -212,33 +182,14 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 	if (isStorageIntern())
 		return;
 
-	if (oldRefCount) {
-		--(*oldRefCount);
-	}
-	if (!oldRefCount || *oldRefCount <= 0) {
-		// The ref count reached zero, so we free the string storage
-		// and the ref count storage.
-		if (oldRefCount) {
-#ifndef SCUMMVM_UTIL
-			lockMemoryPoolMutex();
-#endif
-			assert(g_refCountPool);
-			g_refCountPool->freeChunk(oldRefCount);
-#ifndef SCUMMVM_UTIL
-			unlockMemoryPoolMutex();
-#endif
-		}
-		// Coverity thinks that we always free memory, as it assumes
-		// (correctly) that there are cases when oldRefCount == 0
-		// Thus, DO NOT COMPILE, trick it and shut tons of false positives
-#ifndef __COVERITY__
-		delete[] _str;
-#endif
+	// When the ref count reaches zero, free the string storage, which
+	// also holds the ref count.
+	if (--(*oldRefCount) <= 0)
+		freeStorage(oldRefCount);
 
-		// Even though _str points to a freed memory block now,
-		// we do not change its value, because any code that calls
-		// decRefCount will have to do this afterwards anyway.
-	}
+	// Even though _str points to a freed memory block now,
+	// we do not change its value, because any code that calls
+	// decRefCount will have to do this afterwards anyway.
 }
 
 TEMPLATE void BASESTRING::initWithValueTypeStr(const value_type *str, uint32 len) {
@@ -251,9 +202,7 @@ TEMPLATE void BASESTRING::initWithValueTypeStr(const value_type *str, uint32 len
 	if (len >= _builtinCapacity) {
 		// Not enough internal storage, so allocate more
 		_extern._capacity = computeCapacity(len + 1);
-		_extern._refCount = nullptr;
-		_str = new value_type[_extern._capacity];
-		assert(_str != nullptr);
+		_str = allocStorage<value_type>(_extern._capacity, _extern._refCount);
 	}
 
 	// Copy the string into the storage area
@@ -292,6 +292,13 @@ bool SeekableSubReadStream::seek(int64 offset, int whence) {
 	return ret;
 }
 
+const byte *SeekableSubReadStream::getContiguousData(int64 offset, uint32 size) const {
+	if (offset < 0 || offset > _end - _begin || size > _end - _begin - offset)
+		return nullptr;
+
+	return _parentStream->getContiguousData(_begin + offset, size);
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
@@ -504,6 +511,154 @@ SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStr
 
 namespace {
 
+/**
+ * Wrapper class which reads ahead of the current position of any given
+ * SeekableReadStream in large chunks, and keeps some of the data behind
+ * it for short backward seeks.
+ * @see wrapPrefetchingReadStream
+ */
+class PrefetchingReadStream : public SeekableReadStream {
+protected:
+	DisposablePtr<SeekableReadStream> _parentStream;
+	byte *_buf;
+	const uint32 _windowSize;
+	int64 _bufStart;	///< Position in the parent stream of the first byte in the buffer
+	uint32 _bufLen;		///< Number of valid bytes in the buffer
+	int64 _pos;
+	int64 _parentPos;	///< Position of the parent stream, to avoid needless seeks
+	const int64 _size;
+	bool _eos;
+
+	bool fill();
+
+public:
+	PrefetchingReadStream(SeekableReadStream *parentStream, uint32 windowSize, DisposeAfterUse::Flag disposeParentStream);
+	~PrefetchingReadStream() override;
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _parentStream->err(); }
+	void clearErr() override { _eos = false; _parentStream->clearErr(); }
+
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+
+	// The window is refilled by later reads, so only the parent's own data
+	// can be handed out for the lifetime of the stream
+	const byte *getContiguousData(int64 offset, uint32 size) const override { return _parentStream->getContiguousData(offset, size); }
+};
+
+PrefetchingReadStream::PrefetchingReadStream(SeekableReadStream *parentStream, uint32 windowSize, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(parentStream, disposeParentStream),
+	_windowSize(windowSize),
+	_bufStart(0),
+	_bufLen(0),
+	_pos(parentStream->pos()),
+	_parentPos(_pos),
+	_size(parentStream->size()),
+	_eos(false) {
+
+	assert(windowSize > 0);
+	_buf = new byte[windowSize];
+}
+
+PrefetchingReadStream::~PrefetchingReadStream() {
+	delete[] _buf;
+}
+
+/**
+ * Fill the buffer with as much data from the current position on as fits,
+ * keeping up to a quarter of the window of the data before it. Return false
+ * if nothing could be read.
+ */
+bool PrefetchingReadStream::fill() {
+	const int64 bufEnd = _bufStart + _bufLen;
+
+	if (_pos >= _bufStart && _pos <= bufEnd) {
+		// Sequential access: keep the end of the buffer and append to it
+		const int64 keepStart = MAX<int64>(_bufStart, _pos - _windowSize / 4);
+		const uint32 keep = (uint32)(bufEnd - keepStart);
+		memmove(_buf, _buf + (keepStart - _bufStart), keep);
+		_bufStart = keepStart;
+		_bufLen = keep;
+	} else {
+		_bufStart = _pos;
+		_bufLen = 0;
+	}
+
+	const int64 readPos = _bufStart + _bufLen;
+	if (readPos >= _size)
+		return false;
+
+	if (_parentPos != readPos && !_parentStream->seek(readPos))
+		return false;
+
+	const uint32 n = _parentStream->read(_buf + _bufLen, _windowSize - _bufLen);
+	_bufLen += n;
+	_parentPos = readPos + n;
+	return n > 0;
+}
+
+uint32 PrefetchingReadStream::read(void *dataPtr, uint32 dataSize) {
+	uint32 alreadyRead = 0;
+
+	while (alreadyRead < dataSize) {
+		if (_pos >= _bufStart && _pos < _bufStart + _bufLen) {
+			// Satisfy as much of the request as possible from the buffer
+			const uint32 n = MIN<uint32>(dataSize - alreadyRead, (uint32)(_bufStart + _bufLen - _pos));
+			memcpy((byte *)dataPtr + alreadyRead, _buf + (_pos - _bufStart), n);
+			_pos += n;
+			alreadyRead += n;
+		} else if (dataSize - alreadyRead >= _windowSize) {
+			// Large requests are read directly, without the extra copy
+			if (_parentPos != _pos && !_parentStream->seek(_pos))
+				break;
+			const uint32 n = _parentStream->read((byte *)dataPtr + alreadyRead, dataSize - alreadyRead);
+			_parentPos = _pos + n;
+			_pos += n;
+			alreadyRead += n;
+			break;
+		} else if (!fill()) {
+			break;
+		}
+	}
+
+	if (alreadyRead < dataSize)
+		_eos = true;
+	return alreadyRead;
+}
+
+bool PrefetchingReadStream::seek(int64 offset, int whence) {
+	int64 newPos = offset;
+	if (whence == SEEK_CUR)
+		newPos += _pos;
+	else if (whence == SEEK_END)
+		newPos += _size;
+
+	if (newPos < 0 || newPos > _size)
+		return false;
+
+	// The actual seek in the parent stream is delayed until data outside
+	// of the buffer is needed
+	_pos = newPos;
+	_eos = false;
+	return true;
+}
+
+} // End of anonymous namespace
+
+SeekableReadStream *wrapPrefetchingReadStream(SeekableReadStream *parentStream, uint32 windowSize, DisposeAfterUse::Flag disposeParentStream) {
+	if (parentStream)
+		return new PrefetchingReadStream(parentStream, windowSize, disposeParentStream);
+	return nullptr;
+}
+
+#pragma mark -
+
+namespace {
+
 /**
  * Wrapper class which adds buffering to any WriteStream.
  */
@@ -792,6 +792,23 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Get direct access to a range of the stream data, for streams which
+	 * keep their data in a contiguous block of memory.
+	 *
+	 * This allows parsers to work on the data in place instead of reading
+	 * it into a buffer of their own. The stream position indicator is not
+	 * affected. The returned pointer remains valid for the lifetime of the
+	 * stream.
+	 *
+	 * @param offset	Offset of the range from the start of the stream.
+	 * @param size	Size of the range in bytes.
+	 *
+	 * @return Pointer to the data, or nullptr if the stream is not backed by
+	 *         memory or the range is out of bounds.
+	 */
+	virtual const byte *getContiguousData(int64 offset, uint32 size) const { return nullptr; }
+
 	/**
 	 * Read at most one less than the number of characters specified
 	 * by @p bufSize from the stream and store them in the string buffer.
@@ -982,6 +999,7 @@ public:
 	int64 pos() const override { return _parentStream->pos(); }
 	int64 size() const override { return _parentStream->size(); }
 	bool seek(int64 offset, int whence = SEEK_SET) override { return _parentStream->seek(offset, whence); }
+	const byte *getContiguousData(int64 offset, uint32 size) const override { return _parentStream->getContiguousData(offset, size); }
 };
 
 /** @} */
@@ -1261,6 +1261,18 @@ public:
 	 */
 	virtual void unlockScreen() = 0;
 
+	/**
+	 * Unlock the screen framebuffer, and mark only the given area as dirty.
+	 *
+	 * This is for callers which only changed a part of the framebuffer, such
+	 * as a video decoder drawing its frames straight into it. Backends which
+	 * do not keep track of dirty areas update the whole screen, like
+	 * unlockScreen() does.
+	 *
+	 * @param dirtyRect  The area of the screen which was changed.
+	 */
+	virtual void unlockScreenRect(const Common::Rect &dirtyRect) { unlockScreen(); }
+
 	/**
 	 * Fill the screen with the given color value.
 	 */
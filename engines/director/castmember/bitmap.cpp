@@ -702,6 +702,7 @@ void BitmapCastMember::load() {
 	debugC(5, kDebugImages, "BitmapCastMember::load(): Bitmap: id: %d, w: %d, h: %d, flags1: %x, flags2: %x bytes: %x, bpp: %d clut: %s", imgId, w, h, _flags1, _flags2, _bytes, _bitsPerPixel, _clut.asString().c_str());
 
 	_loaded = true;
+	newRevision();
 }
 
 void BitmapCastMember::unload() {
@@ -715,6 +716,7 @@ void BitmapCastMember::unload() {
 	_ditheredImg = nullptr;
 
 	_loaded = false;
+	newRevision();
 }
 
 PictureReference *BitmapCastMember::getPicture() const {
@@ -865,6 +867,7 @@ bool BitmapCastMember::setField(int field, const Datum &d) {
 			_regX = d.u.farr->arr[0].asInt();
 			_regY = d.u.farr->arr[1].asInt();
 			_modified = true;
+			newRevision();
 		} else {
 			warning("BitmapCastMember::setField(): Wrong Datum type %d for kTheRegPoint", d.type);
 			return false;
@@ -27,6 +27,8 @@
 
 namespace Director {
 
+uint32 CastMember::_lastRevision = 0;
+
 CastMember::CastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndian &stream) : Object<CastMember>("CastMember") {
 	_type = kCastTypeNull;
 	_cast = cast;
@@ -39,6 +41,7 @@ CastMember::CastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndi
 	_loaded = false;
 	_modified = true;
 	_isChanged = false;
+	newRevision();
 	_needsReload = false;
 
 	_objType = kCastMemberObj;
@@ -59,6 +62,7 @@ CastMember::CastMember(Cast *cast, uint16 castId) : Object<CastMember>("CastMemb
 	_loaded = false;
 	_modified = true;
 	_isChanged = false;
+	newRevision();
 
 	_objType = kCastMemberObj;
 
@@ -68,8 +72,10 @@ CastMember::CastMember(Cast *cast, uint16 castId) : Object<CastMember>("CastMemb
 
 void CastMember::setModified(bool modified) {
 	_modified = modified;
-	if (modified)
+	if (modified) {
 		_isChanged = true;
+		newRevision();
+	}
 }
 
 Common::Rect CastMember::getBbox() {
@@ -288,6 +294,7 @@ void CastMember::unload() {
 		return;
 
 	_loaded = false;
+	newRevision();
 }
 
 } // End of namespace Director
@@ -60,6 +60,10 @@ public:
 	virtual void setEditable(bool editable) {}
 	virtual bool isModified() { return _modified; }
 	void setModified(bool modified);
+	// Changes whenever the contents of the member change or it is unloaded.
+	// Revisions are unique across all cast members, so caches keyed on one
+	// never mistake a new member for a freed one.
+	uint32 getRevision() const { return _revision; }
 	virtual Graphics::MacWidget *createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) { return nullptr; }
 	virtual void updateWidget(Graphics::MacWidget *widget, Channel *channel) {}
 	virtual void updateFromWidget(Graphics::MacWidget *widget) {}
@@ -114,6 +118,12 @@ protected:
 	bool _modified;
 	bool _isChanged;
 	bool _needsReload;
+
+	void newRevision() { _revision = ++_lastRevision; }
+
+private:
+	uint32 _revision;
+	static uint32 _lastRevision;
 };
 
 struct EditInfo {
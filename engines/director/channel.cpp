@@ -49,6 +49,7 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 	_widget = nullptr;
 	_constraint = 0;
 	_mask = nullptr;
+	_maskRevision = 0;
 
 	_priority = priority;
 
@@ -77,6 +78,7 @@ Channel& Channel::operator=(const Channel &channel) {
 	_widget = nullptr;
 	_constraint = channel._constraint;
 	_mask = nullptr;
+	_maskRevision = 0;
 
 	_priority = channel._priority;
 
@@ -193,18 +195,27 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 				return nullptr;
 			}
 
-			if (_mask) {
-				delete _mask;
-				_mask = nullptr;
-			}
 			if (bitmap->_picture) {
 				// reposition channel bounding box, so origin is at registration offset
 				Common::Point originPos = getPosition();
 				bbox.translate(-originPos.x, -originPos.y);
-				// create new mask surface, with the exact dimensions of the channel.
-				_mask = new Graphics::ManagedSurface(bbox.width(), bbox.height());
+
 				// get the bounding box of the mask image (origin at registration offset)
 				Common::Rect destRect = bitmap->getBbox();
+
+				// The mask only depends on the mask cast member and the channel
+				// geometry, so keep it around until either of them changes
+				if (_mask && _maskCastId == maskID && _maskRevision == bitmap->getRevision() &&
+						_maskBbox == bbox && _maskSourceBbox == destRect)
+					return &_mask->rawSurface();
+
+				delete _mask;
+				_maskCastId = maskID;
+				_maskRevision = bitmap->getRevision();
+				_maskBbox = bbox;
+				_maskSourceBbox = destRect;
+				// create new mask surface, with the exact dimensions of the channel.
+				_mask = new Graphics::ManagedSurface(bbox.width(), bbox.height());
 				// get position of channel's registration offset (origin at top left)
 				Common::Point channelRegOffset(-bbox.left, -bbox.top);
 				// move destination rect to sit at the channel's registration offset
@@ -219,6 +230,8 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 				_mask->copyRectToSurface(bitmap->_picture->_surface, destRect.left, destRect.top, srcRect);
 				return &_mask->rawSurface();
 			} else {
+				delete _mask;
+				_mask = nullptr;
 				warning("Channel::getMask(): Requested cast mask %s, but no picture found", maskID.asString().c_str());
 				return nullptr;
 			}
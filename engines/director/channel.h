@@ -104,6 +104,11 @@ public:
 	bool _visible;
 	uint _constraint;
 	Graphics::ManagedSurface *_mask;
+	// What _mask was built from, so it can be reused across redraws
+	CastMemberID _maskCastId;
+	uint32 _maskRevision;
+	Common::Rect _maskBbox;
+	Common::Rect _maskSourceBbox;
 
 	int _priority;
 
@@ -515,26 +515,30 @@ void LC::c_proprefpush() {
 }
 
 void LC::c_varpush() {
-	LC::c_varrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = VARREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = GLOBALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_localpush() {
-	LC::c_localrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = LOCALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = PROPREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
@@ -1644,36 +1648,38 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 	// Handler
 	funcSym = g_lingo->getHandler(name);
 
-	if (g_lingo->_builtinListHandlers.contains(name) && nargs >= 1) {
-		// Lingo builtin functions in the "List" category have very strange override mechanics.
-		// If the first argument is an ARRAY or PARRAY, it will use the builtin.
-		// Otherwise, it will fall back to whatever handler is defined globally.
-		Datum firstArg = g_lingo->peek(nargs - 1);
-		if (firstArg.type == ARRAY || firstArg.type == PARRAY ||
-				firstArg.type == POINT || firstArg.type == RECT) {
-			funcSym = g_lingo->_builtinListHandlers[name];
+	if (nargs >= 1) {
+		SymbolHash::iterator it = g_lingo->_builtinListHandlers.find(name);
+		if (it != g_lingo->_builtinListHandlers.end()) {
+			// Lingo builtin functions in the "List" category have very strange override mechanics.
+			// If the first argument is an ARRAY or PARRAY, it will use the builtin.
+			// Otherwise, it will fall back to whatever handler is defined globally.
+			Datum firstArg = g_lingo->peek(nargs - 1);
+			if (firstArg.type == ARRAY || firstArg.type == PARRAY ||
+					firstArg.type == POINT || firstArg.type == RECT) {
+				funcSym = it->_value;
+			}
 		}
 	}
 
 	if (funcSym.type == VOIDSYM) { // The built-ins could be overridden
 		// Builtin
-		if (allowRetVal) {
-			if (g_lingo->_builtinFuncs.contains(name)) {
-				funcSym = g_lingo->_builtinFuncs[name];
-			}
-		} else {
-			if (g_lingo->_builtinCmds.contains(name)) {
-				funcSym = g_lingo->_builtinCmds[name];
-			}
+		SymbolHash &builtins = allowRetVal ? g_lingo->_builtinFuncs : g_lingo->_builtinCmds;
+		SymbolHash::iterator it = builtins.find(name);
+		if (it != builtins.end()) {
+			funcSym = it->_value;
 		}
 	}
 
 	// use lingo-the as fallback. we can only use functions as fallback, not properties
-	if (funcSym.type == VOIDSYM && g_lingo->_theEntities.contains(name) && g_lingo->_theEntities[name]->isFunction) {
-		Datum id;
-		Datum res = g_lingo->getTheEntity(g_lingo->_theEntities[name]->entity, id, kTheNOField);
-		g_lingo->push(res);
-		return;
+	if (funcSym.type == VOIDSYM) {
+		TheEntityHash::iterator it = g_lingo->_theEntities.find(name);
+		if (it != g_lingo->_theEntities.end() && it->_value->isFunction) {
+			Datum id;
+			Datum res = g_lingo->getTheEntity(it->_value->entity, id, kTheNOField);
+			g_lingo->push(res);
+			return;
+		}
 	}
 
 	call(funcSym, nargs, allowRetVal);
@@ -529,6 +529,19 @@ Symbol ScriptContext::getMethod(const Common::String &methodName) {
 	return sym;
 }
 
+AbstractObject *ScriptContext::getScriptAncestor() {
+	// The property name is looked up often enough that it is worth not
+	// building a new string every time.
+	static const Common::String ancestorName("ancestor");
+
+	DatumHash::iterator it = _properties.find(ancestorName);
+	if (it != _properties.end() && it->_value.type == OBJECT
+			&& (it->_value.u.obj->getObjType() & (kScriptObj | kXtraObj))) {
+		return it->_value.u.obj;
+	}
+	return nullptr;
+}
+
 bool ScriptContext::hasProp(const Common::String &propName) {
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
@@ -537,9 +550,9 @@ bool ScriptContext::hasProp(const Common::String &propName) {
 		return true;
 	}
 	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			return _properties["ancestor"].u.obj->hasProp(propName);
+		AbstractObject *ancestor = getScriptAncestor();
+		if (ancestor) {
+			return ancestor->hasProp(propName);
 		}
 	}
 	return false;
@@ -549,14 +562,16 @@ Datum ScriptContext::getProp(const Common::String &propName) {
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		return _properties[propName];
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		return it->_value;
 	}
 	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->getProp(propName);
+		AbstractObject *ancestor = getScriptAncestor();
+		if (ancestor) {
+			if (debugChannelSet(3, kDebugLingoExec))
+				debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), Datum(ancestor).asString(true).c_str());
+			return ancestor->getProp(propName);
 		}
 	}
 	_propertyNames.push_back(propName);
@@ -582,8 +597,9 @@ bool ScriptContext::setProp(const Common::String &propName, const Datum &value,
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		_properties[propName] = value;
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		it->_value = value;
 		return true;
 	}
 	if (force) {
@@ -592,10 +608,11 @@ bool ScriptContext::setProp(const Common::String &propName, const Datum &value,
 		_properties[propName] = value;
 		return true;
 	} else if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->setProp(propName, value, force);
+		AbstractObject *ancestor = getScriptAncestor();
+		if (ancestor) {
+			if (debugChannelSet(3, kDebugLingoExec))
+				debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), Datum(ancestor).asString(true).c_str());
+			return ancestor->setProp(propName, value, force);
 		}
 	} else if (_objType == kFactoryObj) {
 		// D3 style anonymous objects/factories, set whatever properties you like
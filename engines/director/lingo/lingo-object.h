@@ -229,6 +229,8 @@ private:
 	Common::Array<Common::String> _propertyNames;
 	bool _onlyInLctxContexts = false;
 
+	AbstractObject *getScriptAncestor();
+
 public:
 	ScriptContext(Common::String name, ScriptType type = kNoneScript, int id = 0, uint16 castLibHint = 0);
 	ScriptContext(const ScriptContext &sc);
@@ -335,8 +335,11 @@ Symbol Lingo::getHandler(const Common::String &name) {
 	Symbol sym;
 
 	// local functions
-	if (_state->context && _state->context->_functionHandlers.contains(name))
-		return _state->context->_functionHandlers[name];
+	if (_state->context) {
+		SymbolHash::iterator it = _state->context->_functionHandlers.find(name);
+		if (it != _state->context->_functionHandlers.end())
+			return it->_value;
+	}
 
 	sym = g_director->getCurrentMovie()->getHandler(name, _state->context ? _state->context->_castLibHint : 0);
 	if (sym.type != VOIDSYM)
@@ -1664,11 +1667,14 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
-				g_debugger->varWriteHook(name);
-				return;
+			const Common::String &name = *var.u.s;
+			if (_state->localVars) {
+				DatumHash::iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end()) {
+					it->_value = value;
+					g_debugger->varWriteHook(name);
+					return;
+				}
 			}
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
@@ -1688,9 +1694,10 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
+			const Common::String &name = *var.u.s;
+			DatumHash::iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				it->_value = value;
 				g_debugger->varWriteHook(name);
 			} else {
 				warning("varAssign: local variable %s not defined", name.c_str());
@@ -1699,7 +1706,7 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
 				g_debugger->varWriteHook(name);
@@ -1780,18 +1787,20 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Datum d;
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
 
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
+			if (_state->localVars) {
+				DatumHash::iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end())
+					return it->_value;
 			}
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				return _state->me.u.obj->getProp(name);
 			}
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
+			DatumHash::iterator it = _globalvars.find(name);
+			if (it != _globalvars.end()) {
+				return it->_value;
 			}
 
 			if (!silent)
@@ -1801,10 +1810,11 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case GLOBALREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
+			DatumHash::iterator it = _globalvars.find(name);
+			if (it != _globalvars.end()) {
+				return it->_value;
 			}
 			debugC(1, kDebugLingoExec, "varFetch: global variable %s not defined", name.c_str());
 			return result;
@@ -1812,10 +1822,12 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
+			if (_state->localVars) {
+				DatumHash::iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end())
+					return it->_value;
 			}
 			debugC(1, kDebugLingoExec, "varFetch: local variable %s not defined", name.c_str());
 			return result;
@@ -1823,7 +1835,7 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				return _state->me.u.obj->getProp(name);
@@ -91,6 +91,9 @@ Score::Score(Movie *movie) {
 	_curFrameNumber = 1;
 	_framesStream = nullptr;
 	_currentFrame = nullptr;
+
+	_keyframeInterval = 1;
+	_maxKeyframes = ConfMan.hasKey("score_keyframes") ? MAX(ConfMan.getInt("score_keyframes"), 1) : 256;
 }
 
 Score::~Score() {
@@ -106,6 +109,9 @@ Score::~Score() {
 	for (auto &it : _scoreCache)
 		delete it;
 
+	for (auto &it : _keyframes)
+		delete it.frame;
+
 	if (_framesStream)
 		delete _framesStream;
 
@@ -1677,8 +1683,13 @@ void Score::loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version)
 	// numOfFrames in the header is often incorrect
 	for (_numFrames = 1; loadFrame(_numFrames, false); _numFrames++) {
 		_scoreCache.push_back(new Frame(*_currentFrame));
+
+		if (_numFrames % _keyframeInterval == 0)
+			addKeyframe();
 	}
 
+	debugC(1, kDebugLoading, "Score::loadFrames(): Built %d keyframes, interval %d", _keyframes.size(), _keyframeInterval);
+
 	debugC(1, kDebugLoading, "Score::loadFrames(): Calculated, total number of frames %d!", _numFrames);
 
 	_currentFrame->reset();
@@ -1694,7 +1705,21 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 	int sourceFrame = _curFrameNumber;
 	int targetFrame = frameNum;
 
-	if (frameNum <= (int)_curFrameNumber) {
+	// Find the closest keyframe before the target frame. The target frame
+	// itself is always read from the stream, so that we know it exists.
+	const ScoreKeyframe *keyframe = nullptr;
+	for (int i = (int)_keyframes.size() - 1; i >= 0; i--) {
+		if ((int)_keyframes[i].frameNum < targetFrame) {
+			keyframe = &_keyframes[i];
+			break;
+		}
+	}
+
+	if (keyframe && (frameNum <= (int)_curFrameNumber || (int)keyframe->frameNum > sourceFrame)) {
+		debugC(7, kDebugLoading, "****** Restoring keyframe %d at %d", keyframe->frameNum, keyframe->position);
+		restoreKeyframe(*keyframe);
+		sourceFrame = keyframe->frameNum;
+	} else if (frameNum <= (int)_curFrameNumber) {
 		debugC(7, kDebugLoading, "****** Resetting frame %d to start %" PRId64, sourceFrame, _framesStream->pos());
 		// If we are going back, we need to rebuild frames from start
 		_currentFrame->reset();
@@ -1730,6 +1755,46 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 	return true;
 }
 
+void Score::addKeyframe() {
+	// Keep the memory used by the index bounded: when full, drop every
+	// other keyframe and double the interval
+	if (_keyframes.size() >= _maxKeyframes) {
+		uint32 kept = 0;
+		for (uint32 i = 0; i < _keyframes.size(); i++) {
+			if (_keyframes[i].frameNum % (_keyframeInterval * 2) == 0)
+				_keyframes[kept++] = _keyframes[i];
+			else
+				delete _keyframes[i].frame;
+		}
+		_keyframes.resize(kept);
+		_keyframeInterval *= 2;
+
+		if (_curFrameNumber % _keyframeInterval != 0)
+			return;
+	}
+
+	ScoreKeyframe keyframe;
+	keyframe.frameNum = _curFrameNumber;
+	keyframe.position = _framesStream->pos();
+	keyframe.frame = new Frame(*_currentFrame);
+	// The copy constructor only copies what is needed for display
+	keyframe.frame->_mainChannels = _currentFrame->_mainChannels;
+
+	_keyframes.push_back(keyframe);
+}
+
+void Score::restoreKeyframe(const ScoreKeyframe &keyframe) {
+	_currentFrame->_mainChannels = keyframe.frame->_mainChannels;
+
+	for (uint i = 0; i < _currentFrame->_sprites.size(); i++) {
+		Sprite *sprite = _currentFrame->_sprites[i];
+		*sprite = *keyframe.frame->_sprites[i];
+		sprite->_frame = _currentFrame;
+	}
+
+	_framesStream->seek(keyframe.position);
+}
+
 bool Score::readOneFrame() {
 	uint16 channelSize;
 	uint16 channelOffset;
@@ -60,6 +60,16 @@ struct Label {
 	Label(Common::String name1, uint16 number1, Common::String comment1) { name = name1; number = number1; comment = comment1;}
 };
 
+/**
+ * Snapshot of the channel state after a given frame has been read, together
+ * with the position of the following frame in the delta-encoded frame stream.
+ */
+struct ScoreKeyframe {
+	uint32 frameNum;
+	uint32 position;
+	Frame *frame;
+};
+
 class Score {
 public:
 	Score(Movie *movie);
@@ -71,6 +81,8 @@ public:
 	bool loadFrame(int frame, bool loadCast);
 	bool readOneFrame();
 	void updateFrame(Frame *frame);
+	void addKeyframe();
+	void restoreKeyframe(const ScoreKeyframe &keyframe);
 	Frame *getFrameData(int frameNum);
 
 	void loadLabels(Common::SeekableReadStreamEndian &stream);
@@ -170,6 +182,12 @@ public:
 	uint _framesStreamSize;
 	Common::MemoryReadStreamEndian *_framesStream;
 
+	// Keyframe index over _framesStream, so seeking only has to replay
+	// at most _keyframeInterval frame deltas
+	Common::Array<ScoreKeyframe> _keyframes;
+	uint32 _keyframeInterval;
+	uint32 _maxKeyframes;
+
 	byte _currentFrameRate;
 	byte _puppetTempo;
 
@@ -145,6 +145,12 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Direct-mapped cache of decoded instructions, indexed by address. Only instructions in ROM
+	 * are cached, since they can't change while the game runs.
+	 */
+	predecoded_t predecode_cache[PREDECODE_CACHE_SIZE];
+
 	/**@}*/
 
 	/**
@@ -551,6 +557,19 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Decode the opcode and operand modes of the ROM instruction at addr into entry. Returns false
+	 * (leaving the entry invalid) if the instruction can't be cached, in which case it should be
+	 * executed through parse_operands(), which also reports any errors in it.
+	 */
+	bool predecode_instruction(predecoded_t *entry, uint addr);
+
+	/**
+	 * Like parse_operands(), but for an instruction decoded by predecode_instruction(). This
+	 * doesn't move the PC.
+	 */
+	void load_predecoded_operands(oparg_t *opargs, const predecoded_t *entry);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
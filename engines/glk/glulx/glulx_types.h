@@ -351,6 +351,23 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * An instruction in ROM whose opcode and operand modes have already been decoded. Operands
+ * hold the constant or address given by the mode; values are still loaded at execution time.
+ */
+struct predecoded_struct {
+	uint addr;              ///< Address of the instruction, or PREDECODE_INVALID
+	uint opcode;
+	uint nextpc;            ///< Address of the following instruction
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];
+	uint operands[MAX_OPERANDS];
+};
+typedef predecoded_struct predecoded_t;
+
+#define PREDECODE_CACHE_SIZE (2048)
+#define PREDECODE_INVALID (0xFFFFFFFF)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -66,6 +66,9 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	for (int ix = 0; ix < PREDECODE_CACHE_SIZE; ix++)
+		predecode_cache[ix].addr = PREDECODE_INVALID;
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -516,6 +519,195 @@ WrLocalsAddr:
 	}
 }
 
+bool Glulx::predecode_instruction(predecoded_t *entry, uint addr) {
+	uint instaddr = addr;
+	uint opcode;
+	const operandlist_t *oplist;
+
+	entry->addr = PREDECODE_INVALID;
+
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 24) | (Mem1(addr) << 16) | (Mem1(addr + 1) << 8) | Mem1(addr + 2);
+			addr += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		return false;
+
+	int numops = oplist->num_ops;
+	uint modeaddr = addr;
+	addr += (numops + 1) / 2;
+
+	for (int ix = 0; ix < numops; ix++) {
+		int modeval = Mem1(modeaddr + ix / 2);
+		int mode = (ix & 1) ? ((modeval >> 4) & 0x0F) : (modeval & 0x0F);
+		uint operand = 0;
+
+		switch (mode) {
+		case 0: /* constant zero, or discard */
+		case 8: /* stack */
+			break;
+
+		case 1: /* one-byte constant, sign-extended */
+			operand = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2: /* two-byte constant, sign-extended */
+			operand = ((int)(signed char)(Mem1(addr)) << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+
+		case 3: /* four-byte constant */
+			operand = Mem4(addr);
+			addr += 4;
+			break;
+
+		case 5: /* one-byte address */
+		case 9:
+		case 13:
+			operand = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 6: /* two-byte address */
+		case 10:
+		case 14:
+			operand = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 7: /* four-byte address */
+		case 11:
+		case 15:
+			operand = Mem4(addr);
+			addr += 4;
+			break;
+
+		default:
+			return false;
+		}
+
+		if (mode >= 13)
+			operand += ramstart;
+
+		if (oplist->formlist[ix] == modeform_Store && mode >= 1 && mode <= 3)
+			return false;
+
+		entry->modes[ix] = mode;
+		entry->operands[ix] = operand;
+	}
+
+	/* The instruction must lie entirely in ROM. */
+	if (addr > ramstart)
+		return false;
+
+	entry->addr = instaddr;
+	entry->opcode = opcode;
+	entry->nextpc = addr;
+	entry->oplist = oplist;
+	return true;
+}
+
+void Glulx::load_predecoded_operands(oparg_t *args, const predecoded_t *entry) {
+	const operandlist_t *oplist = entry->oplist;
+	int numops = oplist->num_ops;
+	int argsize = oplist->arg_size;
+
+	for (int ix = 0; ix < numops; ix++) {
+		oparg_t *curarg = &args[ix];
+		uint operand = entry->operands[ix];
+		uint value;
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			curarg->desttype = 0;
+
+			switch (entry->modes[ix]) {
+			case 8: /* pop off stack */
+				if (stackptr < valstackbase + 4) {
+					fatal_error("Stack underflow in operand.");
+				}
+				stackptr -= 4;
+				value = Stk4(stackptr);
+				break;
+
+			case 5: /* main memory */
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				if (argsize == 4) {
+					value = Mem4(operand);
+				} else if (argsize == 2) {
+					value = Mem2(operand);
+				} else {
+					value = Mem1(operand);
+				}
+				break;
+
+			case 9: /* locals */
+			case 10:
+			case 11:
+				operand += localsbase;
+				if (argsize == 4) {
+					value = Stk4(operand);
+				} else if (argsize == 2) {
+					value = Stk2(operand);
+				} else {
+					value = Stk1(operand);
+				}
+				break;
+
+			default: /* constants */
+				value = operand;
+				break;
+			}
+
+			curarg->value = value;
+
+		} else { /* modeform_Store */
+			switch (entry->modes[ix]) {
+			case 0: /* discard value */
+				curarg->desttype = 0;
+				curarg->value = 0;
+				break;
+
+			case 8: /* push on stack */
+				curarg->desttype = 3;
+				curarg->value = 0;
+				break;
+
+			case 9: /* locals */
+			case 10:
+			case 11:
+				curarg->desttype = 2;
+				curarg->value = operand;
+				break;
+
+			default: /* main memory */
+				curarg->desttype = 1;
+				curarg->value = operand;
+				break;
+			}
+		}
+	}
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/file.h"
 #include "common/str.h"
@@ -86,6 +87,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("cosdump",   WRAP_METHOD(ScummDebugger, Cmd_Cosdump));
 	registerCmd("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
+	registerCmd("opprofile", WRAP_METHOD(ScummDebugger, Cmd_OpcodeProfile));
 	registerCmd("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
 
 	if (_vm->_game.id == GID_LOOM)
@@ -470,6 +472,63 @@ bool ScummDebugger::Cmd_Script(int argc, const char** argv) {
 	return true;
 }
 
+struct OpcodeProfileLess {
+	bool operator()(const Common::HashMap<uint32, OpcodeProfileEntry>::const_iterator &a,
+					const Common::HashMap<uint32, OpcodeProfileEntry>::const_iterator &b) const {
+		if (a->_value.millis != b->_value.millis)
+			return a->_value.millis > b->_value.millis;
+		return a->_value.count > b->_value.count;
+	}
+};
+
+bool ScummDebugger::Cmd_OpcodeProfile(int argc, const char **argv) {
+	typedef Common::HashMap<uint32, OpcodeProfileEntry>::const_iterator ProfileIterator;
+
+	if (argc < 2) {
+		debugPrintf("Usage: %s on|off|reset|dump [script]\n", argv[0]);
+		debugPrintf("Opcode profiling is %s, %u entries recorded\n",
+				_vm->_opcodeProfiling ? "on" : "off", _vm->_opcodeProfile.size());
+		return true;
+	}
+
+	if (!strcmp(argv[1], "on")) {
+		_vm->_opcodeProfiling = true;
+	} else if (!strcmp(argv[1], "off")) {
+		_vm->_opcodeProfiling = false;
+	} else if (!strcmp(argv[1], "reset")) {
+		_vm->_opcodeProfile.clear();
+	} else if (!strcmp(argv[1], "dump")) {
+		int script = (argc > 2) ? atoi(argv[2]) : -1;
+
+		Common::Array<ProfileIterator> entries;
+		for (ProfileIterator i = _vm->_opcodeProfile.begin(); i != _vm->_opcodeProfile.end(); ++i) {
+			if (script == -1 || (int)(i->_key >> 8) == script)
+				entries.push_back(i);
+		}
+		Common::sort(entries.begin(), entries.end(), OpcodeProfileLess());
+
+		// Without a script filter only show the hottest entries
+		uint num = entries.size();
+		if (script == -1 && num > 40)
+			num = 40;
+
+		debugPrintf("+------+----+------------------------------+----------+--------+\n");
+		debugPrintf("|script| op | name                         |    count |     ms |\n");
+		debugPrintf("+------+----+------------------------------+----------+--------+\n");
+		for (uint i = 0; i < num; i++) {
+			const byte op = entries[i]->_key & 0xFF;
+			debugPrintf("|%6u| %02X | %-28.28s |%10u|%8u|\n",
+					(uint)(entries[i]->_key >> 8), op, _vm->getOpcodeDesc(op),
+					(uint)entries[i]->_value.count, (uint)entries[i]->_value.millis);
+		}
+		debugPrintf("+------+----+------------------------------+----------+--------+\n");
+	} else {
+		debugPrintf("Unknown option '%s'\n", argv[1]);
+	}
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	Common::File file;
 	uint32 size;
@@ -476,18 +476,16 @@ void ScummEngine::resetScriptPointer() {
 }
 
 /**
- * This method checks whether the resource that contains the active script
- * moved, and if so, updates the script pointer accordingly.
+ * This method is called by refreshScriptPointer() when the resource that
+ * contains the active script moved, and updates the script pointer accordingly.
  *
  * The script resource may have moved because it might have been garbage
  * collected by ResourceManager::expireResources.
  */
-void ScummEngine::refreshScriptPointer() {
-	if (*_lastCodePtr != _scriptOrgPointer) {
-		long oldoffs = _scriptPointer - _scriptOrgPointer;
-		getScriptBaseAddress();
-		_scriptPointer = _scriptOrgPointer + oldoffs;
-	}
+void ScummEngine::relocateScriptPointer() {
+	long oldoffs = _scriptPointer - _scriptOrgPointer;
+	getScriptBaseAddress();
+	_scriptPointer = _scriptOrgPointer + oldoffs;
 }
 
 /** Execute a script - Read opcode, and execute it from the table */
@@ -517,11 +515,34 @@ void ScummEngine::executeScript() {
 			debugN("\n");
 		}
 
-		executeOpcode(_opcode);
+		if (_opcodeProfiling)
+			executeProfiledOpcode(_opcode);
+		else
+			executeOpcode(_opcode);
 
 	}
 }
 
+/**
+ * Execute an opcode and account for it in the opcode profile.
+ *
+ * The only timer available is millisecond based, so the time spent is
+ * effectively sampled: each millisecond tick is attributed to the opcode
+ * running when it occurs. Summed over many executions this converges to
+ * the real cost. Time spent in nested scripts started by an opcode is
+ * included in that opcode's total.
+ */
+void ScummEngine::executeProfiledOpcode(byte i) {
+	const uint32 key = (vm.slot[_currentScript].number << 8) | i;
+	const uint32 start = _system->getMillis(true);
+
+	executeOpcode(i);
+
+	OpcodeProfileEntry &entry = _opcodeProfile.getOrCreateVal(key);
+	entry.count++;
+	entry.millis += _system->getMillis(true) - start;
+}
+
 void ScummEngine::executeOpcode(byte i) {
 	if (_opcodes[i].proc && _opcodes[i].proc->isValid())
 		(*_opcodes[i].proc)();
@@ -538,11 +559,6 @@ const char *ScummEngine::getOpcodeDesc(byte i) {
 #endif
 }
 
-byte ScummEngine::fetchScriptByte() {
-	refreshScriptPointer();
-	return *_scriptPointer++;
-}
-
 uint ScummEngine::fetchScriptWord() {
 	refreshScriptPointer();
 	uint a = READ_LE_UINT16(_scriptPointer);
@@ -54,6 +54,16 @@ struct OpcodeEntry : Common::NonCopyable {
 	}
 };
 
+/**
+ * Statistics gathered by the opcode profiler for a single opcode
+ * of a single script.
+ */
+struct OpcodeProfileEntry {
+	uint32 count;
+	uint32 millis;
+
+	OpcodeProfileEntry() : count(0), millis(0) {}
+};
 
 // This is to help devices with small memory (PDA, smartphones, ...)
 // to save abit of memory used by opcode names in the Scumm engine.
@@ -976,8 +976,16 @@ protected:
 
 	OpcodeEntry _opcodes[256];
 
+	/**
+	 * Opcode profiler state, toggled from the debugger "opprofile" command.
+	 * Entries are keyed by (script number << 8) | opcode.
+	 */
+	bool _opcodeProfiling = false;
+	Common::HashMap<uint32, OpcodeProfileEntry> _opcodeProfile;
+
 	virtual void setupOpcodes() = 0;
 	void executeOpcode(byte i);
+	void executeProfiledOpcode(byte i);
 	const char *getOpcodeDesc(byte i);
 
 	void initializeLocals(int slot, int *vars);
@@ -1021,8 +1029,17 @@ protected:
 	void resetScriptPointer();
 	int getVerbEntrypoint(int obj, int entry);
 
-	void refreshScriptPointer();
-	byte fetchScriptByte();
+	// The script pointer has to be revalidated before every fetch, since the
+	// script resource may have been moved. Keep the common case inline.
+	void refreshScriptPointer() {
+		if (*_lastCodePtr != _scriptOrgPointer)
+			relocateScriptPointer();
+	}
+	void relocateScriptPointer();
+	byte fetchScriptByte() {
+		refreshScriptPointer();
+		return *_scriptPointer++;
+	}
 	virtual uint fetchScriptWord();
 	virtual int fetchScriptWordSigned();
 	uint fetchScriptDWord();
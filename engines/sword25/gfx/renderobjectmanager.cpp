@@ -45,7 +45,12 @@
 namespace Sword25 {
 
 void RenderObjectQueue::add(RenderObject *renderObject) {
-	push_back(RenderObjectQueueItem(renderObject, renderObject->getBbox(), renderObject->getVersion()));
+	Node *node = new (_arena) Node(RenderObjectQueueItem(renderObject, renderObject->getBbox(), renderObject->getVersion()), _tail);
+	if (_tail)
+		_tail->_next = node;
+	else
+		_head = node;
+	_tail = node;
 }
 
 bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueItem) {
@@ -57,6 +62,12 @@ bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueIte
 	return false;
 }
 
+void RenderObjectQueue::clear() {
+	// The nodes are trivially destructible, so releasing their memory is enough
+	_arena.reset();
+	_head = _tail = nullptr;
+}
+
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
 	_frameStarted(false) {
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
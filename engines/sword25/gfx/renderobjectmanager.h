@@ -41,6 +41,7 @@
 #ifndef SWORD25_RENDEROBJECTMANAGER_H
 #define SWORD25_RENDEROBJECTMANAGER_H
 
+#include "common/arena.h"
 #include "common/rect.h"
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/renderobjectptr.h"
@@ -63,10 +64,48 @@ struct RenderObjectQueueItem {
 		: _renderObject(renderObject), _bbox(bbox), _version(version) {}
 };
 
-class RenderObjectQueue : public Common::List<RenderObjectQueueItem> {
+/**
+ * The list of objects to draw in a frame. It is rebuilt every frame, so its
+ * entries are allocated from an arena, which is reset with the queue.
+ */
+class RenderObjectQueue {
+private:
+	struct Node {
+		RenderObjectQueueItem _item;
+		Node *_prev;
+		Node *_next;
+		Node(const RenderObjectQueueItem &item, Node *prev) : _item(item), _prev(prev), _next(nullptr) {}
+	};
+
 public:
+	class iterator {
+		friend class RenderObjectQueue;
+		Node *_node;
+		explicit iterator(Node *node) : _node(node) {}
+	public:
+		RenderObjectQueueItem &operator*() const { return _node->_item; }
+		RenderObjectQueueItem *operator->() const { return &_node->_item; }
+		iterator &operator++() { _node = _node->_next; return *this; }
+		iterator &operator--() { _node = _node->_prev; return *this; }
+		bool operator==(const iterator &x) const { return _node == x._node; }
+		bool operator!=(const iterator &x) const { return _node != x._node; }
+	};
+
+	RenderObjectQueue() : _head(nullptr), _tail(nullptr) {}
+
+	iterator begin() { return iterator(_head); }
+	iterator end() { return iterator(nullptr); }
+	/** Iterator to the last entry, to be decremented until it reaches end(). */
+	iterator reverse_begin() { return iterator(_tail); }
+
 	void add(RenderObject *renderObject);
 	bool exists(const RenderObjectQueueItem &renderObjectQueueItem);
+	void clear();
+
+private:
+	Common::Arena _arena;
+	Node *_head;
+	Node *_tail;
 };
 
 /**
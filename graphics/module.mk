@@ -150,11 +150,13 @@ MODULE_OBJS += \
 endif
 ifdef SCUMMVM_SSE2
 MODULE_OBJS += \
-	blit/blit-sse2.o
+	blit/blit-sse2.o \
+	yuv_to_rgb-sse2.o
 endif
 ifdef SCUMMVM_AVX2
 MODULE_OBJS += \
-	blit/blit-avx2.o
+	blit/blit-avx2.o \
+	yuv_to_rgb-avx2.o
 endif
 
 # Include common rules
@@ -0,0 +1,160 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+namespace {
+
+FORCEINLINE __m256i combine(__m128i lo, __m128i hi) {
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+FORCEINLINE __m128i loadChroma8(const int16 *tab, const byte *src) {
+	return _mm_setr_epi16(tab[src[0]], tab[src[1]], tab[src[2]], tab[src[3]],
+	                      tab[src[4]], tab[src[5]], tab[src[6]], tab[src[7]]);
+}
+
+// Loads the chroma contributions for sixteen pixels
+template<bool halfChroma>
+FORCEINLINE __m256i loadChroma(const int16 *tab, const byte *src) {
+	if (halfChroma) {
+		__m128i c = loadChroma8(tab, src);
+		return combine(_mm_unpacklo_epi16(c, c), _mm_unpackhi_epi16(c, c));
+	}
+
+	return combine(loadChroma8(tab, src), loadChroma8(tab, src + 8));
+}
+
+template<bool halfChroma>
+FORCEINLINE __m256i loadChroma(const int16 *tab1, const int16 *tab2, const byte *src1, const byte *src2) {
+	return _mm256_add_epi16(loadChroma<halfChroma>(tab1, src1), loadChroma<halfChroma>(tab2, src2));
+}
+
+// Does the same as the clip table, apart from the color loss
+template<bool itu>
+FORCEINLINE __m256i clipChannel(__m256i x) {
+	if (!itu)
+		return _mm256_min_epi16(_mm256_max_epi16(x, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+
+	x = _mm256_sub_epi16(_mm256_min_epi16(_mm256_max_epi16(x, _mm256_set1_epi16(16)), _mm256_set1_epi16(235)), _mm256_set1_epi16(16));
+
+	// (x * 255) / 219, with the division done as a multiplication and a
+	// shift which give the same result for every multiple of 255 up to 219 * 255
+	x = _mm256_mullo_epi16(x, _mm256_set1_epi16(255));
+	return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16((short)38305)), 7);
+}
+
+struct PixelParams {
+	__m128i rLoss, gLoss, bLoss;
+	__m128i rShift, gShift, bShift;
+	uint32 aMask;
+
+	PixelParams(const Graphics::PixelFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aMask = (0xFF >> format.aLoss) << format.aShift;
+	}
+};
+
+FORCEINLINE void storePixels(uint16 *dst, __m256i r, __m256i g, __m256i b, const PixelParams &params) {
+	__m256i pixels = _mm256_or_si256(_mm256_sll_epi16(r, params.rShift), _mm256_sll_epi16(g, params.gShift));
+	pixels = _mm256_or_si256(pixels, _mm256_or_si256(_mm256_sll_epi16(b, params.bShift), _mm256_set1_epi16((short)params.aMask)));
+	_mm256_storeu_si256((__m256i *)dst, pixels);
+}
+
+FORCEINLINE __m256i packPixels32(__m128i r, __m128i g, __m128i b, const PixelParams &params) {
+	__m256i pixels = _mm256_or_si256(_mm256_sll_epi32(_mm256_cvtepu16_epi32(r), params.rShift), _mm256_sll_epi32(_mm256_cvtepu16_epi32(g), params.gShift));
+	return _mm256_or_si256(pixels, _mm256_or_si256(_mm256_sll_epi32(_mm256_cvtepu16_epi32(b), params.bShift), _mm256_set1_epi32(params.aMask)));
+}
+
+FORCEINLINE void storePixels(uint32 *dst, __m256i r, __m256i g, __m256i b, const PixelParams &params) {
+	_mm256_storeu_si256((__m256i *)dst, packPixels32(_mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b), params));
+	_mm256_storeu_si256((__m256i *)(dst + 8), packPixels32(_mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1), params));
+}
+
+template<typename PixelInt, bool halfChroma, bool itu>
+int convertRow(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBLookup *lookup) {
+	const int16 *crRTab = lookup->getChromaTable();
+	const int16 *crGTab = crRTab + 256;
+	const int16 *cbGTab = crGTab + 256;
+	const int16 *cbBTab = cbGTab + 256;
+	const PixelParams params(lookup->getFormat());
+
+	const int count = width & ~15;
+	for (int x = 0; x < count; x += 16) {
+		const int c = halfChroma ? (x >> 1) : x;
+		const __m256i crR = loadChroma<halfChroma>(crRTab, vSrc + c);
+		const __m256i crbG = loadChroma<halfChroma>(crGTab, cbGTab, vSrc + c, uSrc + c);
+		const __m256i cbB = loadChroma<halfChroma>(cbBTab, uSrc + c);
+
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(ySrc + x)));
+		const __m256i r = _mm256_srl_epi16(clipChannel<itu>(_mm256_add_epi16(y, crR)), params.rLoss);
+		const __m256i g = _mm256_srl_epi16(clipChannel<itu>(_mm256_add_epi16(y, crbG)), params.gLoss);
+		const __m256i b = _mm256_srl_epi16(clipChannel<itu>(_mm256_add_epi16(y, cbB)), params.bLoss);
+		storePixels(dst + x, r, g, b, params);
+	}
+
+	return count;
+}
+
+} // End of anonymous namespace
+
+template<typename PixelInt>
+int convertYUVRowAVX2(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup) {
+	if (lookup->getScale() == YUVToRGBManager::kScaleITU) {
+		if (halfChroma)
+			return convertRow<PixelInt, true, true>(dst, ySrc, uSrc, vSrc, width, lookup);
+		return convertRow<PixelInt, false, true>(dst, ySrc, uSrc, vSrc, width, lookup);
+	}
+
+	if (halfChroma)
+		return convertRow<PixelInt, true, false>(dst, ySrc, uSrc, vSrc, width, lookup);
+	return convertRow<PixelInt, false, false>(dst, ySrc, uSrc, vSrc, width, lookup);
+}
+
+template int convertYUVRowAVX2<uint16>(uint16 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+template int convertYUVRowAVX2<uint32>(uint32 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+namespace {
+
+// Loads the chroma contributions for eight pixels
+template<bool halfChroma>
+FORCEINLINE __m128i loadChroma(const int16 *tab, const byte *src) {
+	if (halfChroma) {
+		__m128i c = _mm_setr_epi16(tab[src[0]], tab[src[1]], tab[src[2]], tab[src[3]], 0, 0, 0, 0);
+		return _mm_unpacklo_epi16(c, c);
+	}
+
+	return _mm_setr_epi16(tab[src[0]], tab[src[1]], tab[src[2]], tab[src[3]],
+	                      tab[src[4]], tab[src[5]], tab[src[6]], tab[src[7]]);
+}
+
+template<bool halfChroma>
+FORCEINLINE __m128i loadChroma(const int16 *tab1, const int16 *tab2, const byte *src1, const byte *src2) {
+	if (halfChroma) {
+		__m128i c = _mm_setr_epi16(tab1[src1[0]] + tab2[src2[0]], tab1[src1[1]] + tab2[src2[1]],
+		                           tab1[src1[2]] + tab2[src2[2]], tab1[src1[3]] + tab2[src2[3]], 0, 0, 0, 0);
+		return _mm_unpacklo_epi16(c, c);
+	}
+
+	return _mm_add_epi16(loadChroma<false>(tab1, src1), loadChroma<false>(tab2, src2));
+}
+
+// Does the same as the clip table, apart from the color loss
+template<bool itu>
+FORCEINLINE __m128i clipChannel(__m128i x) {
+	if (!itu)
+		return _mm_min_epi16(_mm_max_epi16(x, _mm_setzero_si128()), _mm_set1_epi16(255));
+
+	x = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(x, _mm_set1_epi16(16)), _mm_set1_epi16(235)), _mm_set1_epi16(16));
+
+	// (x * 255) / 219, with the division done as a multiplication and a
+	// shift which give the same result for every multiple of 255 up to 219 * 255
+	x = _mm_mullo_epi16(x, _mm_set1_epi16(255));
+	return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((short)38305)), 7);
+}
+
+struct PixelParams {
+	__m128i rLoss, gLoss, bLoss;
+	__m128i rShift, gShift, bShift;
+	uint32 aMask;
+
+	PixelParams(const Graphics::PixelFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aMask = (0xFF >> format.aLoss) << format.aShift;
+	}
+};
+
+FORCEINLINE void storePixels(uint16 *dst, __m128i r, __m128i g, __m128i b, const PixelParams &params) {
+	__m128i pixels = _mm_or_si128(_mm_sll_epi16(r, params.rShift), _mm_sll_epi16(g, params.gShift));
+	pixels = _mm_or_si128(pixels, _mm_or_si128(_mm_sll_epi16(b, params.bShift), _mm_set1_epi16((short)params.aMask)));
+	_mm_storeu_si128((__m128i *)dst, pixels);
+}
+
+FORCEINLINE __m128i packPixels32(__m128i r, __m128i g, __m128i b, const PixelParams &params) {
+	__m128i pixels = _mm_or_si128(_mm_sll_epi32(r, params.rShift), _mm_sll_epi32(g, params.gShift));
+	return _mm_or_si128(pixels, _mm_or_si128(_mm_sll_epi32(b, params.bShift), _mm_set1_epi32(params.aMask)));
+}
+
+FORCEINLINE void storePixels(uint32 *dst, __m128i r, __m128i g, __m128i b, const PixelParams &params) {
+	const __m128i zero = _mm_setzero_si128();
+	_mm_storeu_si128((__m128i *)dst, packPixels32(_mm_unpacklo_epi16(r, zero), _mm_unpacklo_epi16(g, zero), _mm_unpacklo_epi16(b, zero), params));
+	_mm_storeu_si128((__m128i *)(dst + 4), packPixels32(_mm_unpackhi_epi16(r, zero), _mm_unpackhi_epi16(g, zero), _mm_unpackhi_epi16(b, zero), params));
+}
+
+template<typename PixelInt, bool halfChroma, bool itu>
+int convertRow(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVToRGBLookup *lookup) {
+	const int16 *crRTab = lookup->getChromaTable();
+	const int16 *crGTab = crRTab + 256;
+	const int16 *cbGTab = crGTab + 256;
+	const int16 *cbBTab = cbGTab + 256;
+	const PixelParams params(lookup->getFormat());
+
+	const int count = width & ~7;
+	for (int x = 0; x < count; x += 8) {
+		const int c = halfChroma ? (x >> 1) : x;
+		const __m128i crR = loadChroma<halfChroma>(crRTab, vSrc + c);
+		const __m128i crbG = loadChroma<halfChroma>(crGTab, cbGTab, vSrc + c, uSrc + c);
+		const __m128i cbB = loadChroma<halfChroma>(cbBTab, uSrc + c);
+
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + x)), _mm_setzero_si128());
+		const __m128i r = _mm_srl_epi16(clipChannel<itu>(_mm_add_epi16(y, crR)), params.rLoss);
+		const __m128i g = _mm_srl_epi16(clipChannel<itu>(_mm_add_epi16(y, crbG)), params.gLoss);
+		const __m128i b = _mm_srl_epi16(clipChannel<itu>(_mm_add_epi16(y, cbB)), params.bLoss);
+		storePixels(dst + x, r, g, b, params);
+	}
+
+	return count;
+}
+
+} // End of anonymous namespace
+
+template<typename PixelInt>
+int convertYUVRowSSE2(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup) {
+	if (lookup->getScale() == YUVToRGBManager::kScaleITU) {
+		if (halfChroma)
+			return convertRow<PixelInt, true, true>(dst, ySrc, uSrc, vSrc, width, lookup);
+		return convertRow<PixelInt, false, true>(dst, ySrc, uSrc, vSrc, width, lookup);
+	}
+
+	if (halfChroma)
+		return convertRow<PixelInt, true, false>(dst, ySrc, uSrc, vSrc, width, lookup);
+	return convertRow<PixelInt, false, false>(dst, ySrc, uSrc, vSrc, width, lookup);
+}
+
+template int convertYUVRowSSE2<uint16>(uint16 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+template int convertYUVRowSSE2<uint32>(uint32 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -82,8 +82,10 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -91,22 +93,6 @@ DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 
 namespace Graphics {
 
-class YUVToRGBLookup {
-public:
-	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
-
-	Graphics::PixelFormat getFormat() const { return _format; }
-	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
-	const int16 *getColorTable() const { return _colorTab; }
-	const byte *getClipTable() const { return _clipTable; }
-
-private:
-	Graphics::PixelFormat _format;
-	YUVToRGBManager::LuminanceScale _scale;
-	int16 _colorTab[4 * 256]; // 2048 bytes
-	byte _clipTable[3 * 768];
-};
-
 YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
 	_format = format;
 	_scale = scale;
@@ -174,15 +160,23 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 		// would be done here. See the Berkeley mpeg_play sources.
 
 		int16 CR = (i - 128), CB = CR;
-		Cr_r_tab[i] = (int16) ( (0.419 / 0.299) * CR) + r_offset + 256;
-		Cr_g_tab[i] = (int16) (-(0.299 / 0.419) * CR) + g_offset + 256;
-		Cb_g_tab[i] = (int16) (-(0.114 / 0.331) * CB);
-		Cb_b_tab[i] = (int16) ( (0.587 / 0.331) * CB) + b_offset + 256;
+		_chromaTab[0 * 256 + i] = (int16) ( (0.419 / 0.299) * CR);
+		_chromaTab[1 * 256 + i] = (int16) (-(0.299 / 0.419) * CR);
+		_chromaTab[2 * 256 + i] = (int16) (-(0.114 / 0.331) * CB);
+		_chromaTab[3 * 256 + i] = (int16) ( (0.587 / 0.331) * CB);
+
+		Cr_r_tab[i] = _chromaTab[0 * 256 + i] + r_offset + 256;
+		Cr_g_tab[i] = _chromaTab[1 * 256 + i] + g_offset + 256;
+		Cb_g_tab[i] = _chromaTab[2 * 256 + i];
+		Cb_b_tab[i] = _chromaTab[3 * 256 + i] + b_offset + 256;
 	}
 }
 
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_rowFunc16 = nullptr;
+	_rowFunc32 = nullptr;
+	_rowFuncsSelected = false;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
@@ -198,12 +192,31 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+void YUVToRGBManager::selectRowFuncs() {
+	// Pick the fastest row conversion the CPU supports. Without one, the
+	// whole image goes through the lookup tables.
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		_rowFunc16 = convertYUVRowSSE2<uint16>;
+		_rowFunc32 = convertYUVRowSSE2<uint32>;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		_rowFunc16 = convertYUVRowAVX2<uint16>;
+		_rowFunc32 = convertYUVRowAVX2<uint32>;
+	}
+#endif
+
+	_rowFuncsSelected = true;
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
 
 template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc<PixelInt> rowFunc, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = lookup->getColorTable();
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
@@ -217,7 +230,16 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+		int w = 0;
+		if (rowFunc) {
+			w = rowFunc((PixelInt *)dstPtr, ySrc, uSrc, vSrc, yWidth, false, lookup);
+			dstPtr += w * sizeof(PixelInt);
+			ySrc += w;
+			uSrc += w;
+			vSrc += w;
+		}
+
+		for (; w < yWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -245,16 +267,18 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	if (!_rowFuncsSelected)
+		selectRowFuncs();
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _rowFunc16, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _rowFunc32, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
-void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc<PixelInt> rowFunc, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfWidth = yWidth >> 1;
 
 	// Keep the tables in pointers here to avoid a dereference on each pixel
@@ -270,7 +294,16 @@ void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int w = 0;
+		if (rowFunc) {
+			w = rowFunc((PixelInt *)dstPtr, ySrc, uSrc, vSrc, yWidth, true, lookup) >> 1;
+			dstPtr += (w << 1) * sizeof(PixelInt);
+			ySrc += w << 1;
+			uSrc += w;
+			vSrc += w;
+		}
+
+		for (; w < halfWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -302,16 +335,18 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	if (!_rowFuncsSelected)
+		selectRowFuncs();
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _rowFunc16, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _rowFunc32, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc<PixelInt> rowFunc, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfHeight = yHeight >> 1;
 	int halfWidth = yWidth >> 1;
 
@@ -328,7 +363,19 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int w = 0;
+		if (rowFunc) {
+			// Both rows share the chroma samples, so they convert equally far
+			w = rowFunc((PixelInt *)dstPtr, ySrc, uSrc, vSrc, yWidth, true, lookup);
+			rowFunc((PixelInt *)(dstPtr + dstPitch), ySrc + yPitch, uSrc, vSrc, yWidth, true, lookup);
+			w >>= 1;
+			dstPtr += (w << 1) * sizeof(PixelInt);
+			ySrc += w << 1;
+			uSrc += w;
+			vSrc += w;
+		}
+
+		for (; w < halfWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -363,12 +410,14 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	if (!_rowFuncsSelected)
+		selectRowFuncs();
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _rowFunc16, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _rowFunc32, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 #define PUT_PIXELA(s, a, d) \
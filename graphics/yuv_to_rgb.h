@@ -41,10 +41,21 @@
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
+class YUVToRGBTestSuite;
+
 namespace Graphics {
 
 class YUVToRGBLookup;
 
+/**
+ * Converts the start of a row of YUV pixels, using one chroma sample for
+ * every pixel, or for every pair of pixels if halfChroma is set.
+ *
+ * @return the number of pixels converted, which is always even
+ */
+template<typename PixelInt>
+using YUVToRGBRowFunc = int (*)(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
 	/** The scale of the luminance values */
@@ -137,12 +148,19 @@ public:
 
 private:
 	friend class Common::Singleton<SingletonBaseType>;
+	friend class ::YUVToRGBTestSuite;
 	YUVToRGBManager();
 	~YUVToRGBManager();
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
+	void selectRowFuncs();
 
 	YUVToRGBLookup *_lookup;
+
+	// SIMD row conversions for 444, 422 and 420 images, or nullptr
+	YUVToRGBRowFunc<uint16> _rowFunc16;
+	YUVToRGBRowFunc<uint32> _rowFunc32;
+	bool _rowFuncsSelected;
 };
  /** @} */
 } // End of namespace Graphics
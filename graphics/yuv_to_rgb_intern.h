@@ -0,0 +1,68 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "graphics/pixelformat.h"
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+class YUVToRGBLookup {
+public:
+	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
+
+	Graphics::PixelFormat getFormat() const { return _format; }
+	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
+	const int16 *getColorTable() const { return _colorTab; }
+	const byte *getClipTable() const { return _clipTable; }
+
+	/**
+	 * The chroma contributions to red (from V), green (from V and from U)
+	 * and blue (from U), without the clip table offsets of the color table.
+	 */
+	const int16 *getChromaTable() const { return _chromaTab; }
+
+private:
+	Graphics::PixelFormat _format;
+	YUVToRGBManager::LuminanceScale _scale;
+	int16 _colorTab[4 * 256]; // 2048 bytes
+	int16 _chromaTab[4 * 256];
+	byte _clipTable[3 * 768];
+};
+
+// The SIMD row conversions produce exactly the same pixels as the lookup
+// tables, so that the table code can finish off the end of each row.
+
+#ifdef SCUMMVM_SSE2
+template<typename PixelInt>
+int convertYUVRowSSE2(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+#endif
+
+#ifdef SCUMMVM_AVX2
+template<typename PixelInt>
+int convertYUVRowAVX2(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, bool halfChroma, const YUVToRGBLookup *lookup);
+#endif
+
+} // End of namespace Graphics
+
+#endif
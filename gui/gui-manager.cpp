@@ -114,7 +114,6 @@ void GuiManager::initIconsSet() {
 	_iconsSet.clear();
 #ifdef EMSCRIPTEN
 	Common::Path iconsPath = ConfMan.getPath("iconspath");
-	_iconsSet = Common::SearchSet();
 	_iconsSet.addDirectory("gui-icons/", iconsPath, 0, 3, false);
 	_iconsSetChanged = true;
 #else
@@ -59,6 +59,9 @@ struct ResultFormat {
 
 } static *g_result;
 
+// Checksum sizes reported for each file, besides the 5000 byte tail checksum
+static const uint32 kChecksumSizes[] = { 0, 5000, 1024 * 1024 };
+
 struct ChecksumDialogState {
 	IntegrityDialog *dialog;
 	ProcessState state;
@@ -334,18 +337,19 @@ Common::Array<Common::StringArray> IntegrityDialog::generateChecksums(Common::Pa
 
 				Common::Array<Common::String> fileChecksum = {filename.toString()};
 
-				// Data fork
-				// Various checksizes
-				for (auto size : {0, 5000, 1024 * 1024}) {
-					fileChecksum.push_back(Common::computeStreamMD5AsString(*dataForkStream, size).c_str());
-					dataForkStream->seek(0);
-				}
-				// Tail checksums with checksize 5000
-				dataForkStream->seek(-5000, SEEK_END);
-				fileChecksum.push_back(Common::computeStreamMD5AsString(*dataForkStream).c_str());
-
-				// Resource fork
+				// Only files with a resource fork get the Mac checksums
 				if (macFile.hasResFork()) {
+					// Data fork
+					// Various checksizes, computed in a single pass
+					Common::String md5s[ARRAYSIZE(kChecksumSizes)];
+					Common::computeStreamMD5sAsString(*dataForkStream, kChecksumSizes, ARRAYSIZE(kChecksumSizes), md5s);
+					for (uint i = 0; i < ARRAYSIZE(md5s); i++)
+						fileChecksum.push_back(md5s[i]);
+					// Tail checksums with checksize 5000
+					dataForkStream->seek(-5000, SEEK_END);
+					fileChecksum.push_back(Common::computeStreamMD5AsString(*dataForkStream).c_str());
+
+					// Resource fork
 					// Various checksizes
 					for (auto size : {0, 5000, 1024 * 1024}) {
 						fileChecksum.push_back(macFile.computeResForkMD5AsString(size).c_str());
@@ -363,11 +367,11 @@ Common::Array<Common::StringArray> IntegrityDialog::generateChecksums(Common::Pa
 				continue;
 
 			Common::Array<Common::String> fileChecksum = {filename.toString()};
-			// Various checksizes
-			for (auto size : {0, 5000, 1024 * 1024}) {
-				fileChecksum.push_back(Common::computeStreamMD5AsString(file, size).c_str());
-				file.seek(0);
-			}
+			// Various checksizes, computed in a single pass
+			Common::String md5s[ARRAYSIZE(kChecksumSizes)];
+			Common::computeStreamMD5sAsString(file, kChecksumSizes, ARRAYSIZE(kChecksumSizes), md5s);
+			for (uint i = 0; i < ARRAYSIZE(md5s); i++)
+				fileChecksum.push_back(md5s[i]);
 			// Tail checksums with checksize 5000
 			file.seek(-5000, SEEK_END);
 			fileChecksum.push_back(Common::computeStreamMD5AsString(file).c_str());
@@ -58,15 +58,17 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 
 /**
  * The default codebook converter for 24bpp: RGB output.
+ *
+ * The codebook colors are converted to the output format when the
+ * codebook is loaded, so the blocks only need to be filled.
  */
 struct CodebookConverterRGB {
 	template<typename PixelInt>
 	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
 		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		const int8 u = codebook.u, v = codebook.v;
 
-		const PixelInt rgb0 = convertYUVToColor(clipTable, format, codebook.y[0], u, v);
-		const PixelInt rgb1 = convertYUVToColor(clipTable, format, codebook.y[1], u, v);
+		const PixelInt rgb0 = codebook.rgb[0];
+		const PixelInt rgb1 = codebook.rgb[1];
 
 		dst[0] = dst[1] = rgb0;
 		dst[2] = dst[3] = rgb1;
@@ -76,8 +78,8 @@ struct CodebookConverterRGB {
 		dst[2] = dst[3] = rgb1;
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		const PixelInt rgb2 = convertYUVToColor(clipTable, format, codebook.y[2], u, v);
-		const PixelInt rgb3 = convertYUVToColor(clipTable, format, codebook.y[3], u, v);
+		const PixelInt rgb2 = codebook.rgb[2];
+		const PixelInt rgb3 = codebook.rgb[3];
 
 		dst[0] = dst[1] = rgb2;
 		dst[2] = dst[3] = rgb3;
@@ -93,31 +95,31 @@ struct CodebookConverterRGB {
 		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
 		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
+		dst[0] = codebook1.rgb[0];
+		dst[1] = codebook1.rgb[1];
+		dst[2] = codebook2.rgb[0];
+		dst[3] = codebook2.rgb[1];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
+		dst[0] = codebook1.rgb[2];
+		dst[1] = codebook1.rgb[3];
+		dst[2] = codebook2.rgb[2];
+		dst[3] = codebook2.rgb[3];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
 		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
 		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
+		dst[0] = codebook3.rgb[0];
+		dst[1] = codebook3.rgb[1];
+		dst[2] = codebook4.rgb[0];
+		dst[3] = codebook4.rgb[1];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+		dst[0] = codebook3.rgb[2];
+		dst[1] = codebook3.rgb[3];
+		dst[2] = codebook4.rgb[2];
+		dst[3] = codebook4.rgb[3];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 	}
 };
@@ -331,14 +333,6 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 	_curFrame.height = stream.readUint16BE();
 	_curFrame.stripCount = stream.readUint16BE();
 
-	if (!_curFrame.strips) {
-		_curFrame.strips = new CinepakStrip[_curFrame.stripCount];
-		for (uint16 i = 0; i < _curFrame.stripCount; i++) {
-			initializeCodebook(i, 1);
-			initializeCodebook(i, 4);
-		}
-	}
-
 	debug(4, "Cinepak Frame: Width = %d, Height = %d, Strip Count = %d", _curFrame.width, _curFrame.height, _curFrame.stripCount);
 
 	// Borrowed from FFMPEG. This should cut out the extra data Cinepak for Sega has (which is useless).
@@ -355,6 +349,15 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
 	}
 
+	// The codebooks are converted to the format of the surface, so it has to exist first
+	if (!_curFrame.strips) {
+		_curFrame.strips = new CinepakStrip[_curFrame.stripCount];
+		for (uint16 i = 0; i < _curFrame.stripCount; i++) {
+			initializeCodebook(i, 1);
+			initializeCodebook(i, 4);
+		}
+	}
+
 	_y = 0;
 
 	for (uint16 i = 0; i < _curFrame.stripCount; i++) {
@@ -365,9 +368,11 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				_curFrame.strips[i].v4_codebook[j] = _curFrame.strips[i - 1].v4_codebook[j];
 			}
 
-			// Copy the dither tables
-			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * sizeof(uint32));
-			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * sizeof(uint32));
+			// Copy the dither tables, if we're dithering
+			if (_ditherType != kDitherTypeUnknown) {
+				memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * sizeof(uint32));
+				memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * sizeof(uint32));
+			}
 		}
 
 		_curFrame.strips[i].id = stream.readUint16BE();
@@ -439,6 +444,7 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 		memset(codebook[i].y, 0, 4);
 		codebook[i].u = 0;
 		codebook[i].v = 0;
+		convertCodebook(codebook[i]);
 
 		if (_ditherType == kDitherTypeQT)
 			ditherCodebookQT(strip, codebookType, i);
@@ -447,6 +453,17 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 	}
 }
 
+void CinepakDecoder::convertCodebook(CinepakCodebook &codebook) const {
+	const Graphics::PixelFormat &format = _curFrame.surface->format;
+
+	// Palettized output uses the luminance or the dither tables instead
+	if (format.bytesPerPixel == 1)
+		return;
+
+	for (int i = 0; i < 4; i++)
+		codebook.rgb[i] = convertYUVToColor(_clipTable, format, codebook.y[i], codebook.u, codebook.v);
+}
+
 void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize) {
 	CinepakCodebook *codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook : _curFrame.strips[strip].v4_codebook;
 
@@ -480,6 +497,8 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
+			convertCodebook(codebook[i]);
+
 			// Dither the codebook if we're dithering for QuickTime
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
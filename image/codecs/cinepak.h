@@ -39,6 +39,9 @@ struct CinepakCodebook {
 	// These are not in the normal YUV colorspace, but in the Cinepak YUV colorspace instead.
 	byte y[4]; // [0, 255]
 	int8 u, v; // [-128, 127]
+
+	// The four colors in the output pixel format, when it isn't palettized
+	uint32 rgb[4];
 };
 
 struct CinepakStrip {
@@ -96,6 +99,7 @@ private:
 	DitherType _ditherType;
 
 	void initializeCodebook(uint16 strip, byte codebookType);
+	void convertCodebook(CinepakCodebook &codebook) const;
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors8(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 	void decodeVectors24(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
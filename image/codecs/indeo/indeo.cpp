@@ -474,6 +474,11 @@ IndeoDecoderBase::IndeoDecoderBase(uint16 width, uint16 height, uint bitsPerPixe
 		_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 
 	_ctx._bRefBuf = 3; // buffer 2 is used for scalability mode
+
+	_useSSE2 = false;
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
 }
 
 IndeoDecoderBase::~IndeoDecoderBase() {
@@ -731,7 +736,13 @@ void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
 	const short *b3Ptr = _plane->_bands[3]._buf;
 
 	for (int y = 0; y < _plane->_height; y += 2) {
-		for (int x = 0, indx = 0; x < _plane->_width; x += 2, indx++) {
+		int x = 0;
+#ifdef SCUMMVM_SSE2
+		if (_useSSE2)
+			x = IndeoDSP::recomposeHaarRowSSE2(b0Ptr, b1Ptr, b2Ptr, b3Ptr, dst, dstPitch, _plane->_width);
+#endif
+
+		for (int indx = x >> 1; x < _plane->_width; x += 2, indx++) {
 			// load coefficients
 			int b0 = b0Ptr[indx]; //should be: b0 = (_numBands > 0) ? b0Ptr[indx] : 0;
 			int b1 = b1Ptr[indx]; //should be: b1 = (_numBands > 1) ? b1Ptr[indx] : 0;
@@ -921,7 +932,13 @@ void IndeoDecoderBase::outputPlane(IVIPlaneDesc *_plane, uint8 *dst, int dstPitc
 		return;
 
 	for (int y = 0; y < _plane->_height; y++) {
-		for (int x = 0; x < _plane->_width; x++)
+		int x = 0;
+#ifdef SCUMMVM_SSE2
+		if (_useSSE2)
+			x = IndeoDSP::outputRowSSE2(src, dst, _plane->_width);
+#endif
+
+		for (; x < _plane->_width; x++)
 			dst[x] = avClipUint8(src[x] + 128);
 		src += pitch;
 		dst += dstPitch;
@@ -1002,6 +1019,11 @@ int IndeoDecoderBase::processEmptyTile(IVIBandDesc *band,
 		int numBlocks = (band->_mbSize != band->_blkSize) ? 4 : 1; // number of blocks per mb
 		IviMCFunc mcNoDeltaFunc = (band->_blkSize == 8) ? IndeoDSP::ffIviMc8x8NoDelta
 			: IndeoDSP::ffIviMc4x4NoDelta;
+#ifdef SCUMMVM_SSE2
+		if (_useSSE2)
+			mcNoDeltaFunc = (band->_blkSize == 8) ? IndeoDSP::ffIviMc8x8NoDeltaSSE2
+				: IndeoDSP::ffIviMc4x4NoDeltaSSE2;
+#endif
 
 		int mbn;
 		for (mbn = 0, mb = tile->_mbs; mbn < tile->_numMBs; mb++, mbn++) {
@@ -1079,6 +1101,22 @@ int IndeoDecoderBase::decodeBlocks(GetBits *_gb, IVIBandDesc *band, IVITile *til
 		mcAvgNoDeltaFunc   = IndeoDSP::ffIviMcAvg4x4NoDelta;
 	}
 
+#ifdef SCUMMVM_SSE2
+	if (_useSSE2) {
+		if (blkSize == 8) {
+			mcWithDeltaFunc    = IndeoDSP::ffIviMc8x8DeltaSSE2;
+			mcNoDeltaFunc      = IndeoDSP::ffIviMc8x8NoDeltaSSE2;
+			mcAvgWithDeltaFunc = IndeoDSP::ffIviMcAvg8x8DeltaSSE2;
+			mcAvgNoDeltaFunc   = IndeoDSP::ffIviMcAvg8x8NoDeltaSSE2;
+		} else {
+			mcWithDeltaFunc    = IndeoDSP::ffIviMc4x4DeltaSSE2;
+			mcNoDeltaFunc      = IndeoDSP::ffIviMc4x4NoDeltaSSE2;
+			mcAvgWithDeltaFunc = IndeoDSP::ffIviMcAvg4x4DeltaSSE2;
+			mcAvgNoDeltaFunc   = IndeoDSP::ffIviMcAvg4x4NoDeltaSSE2;
+		}
+	}
+#endif
+
 	int mbn;
 	IVIMbInfo *mb;
 
@@ -523,6 +523,7 @@ protected:
 	uint _bitsPerPixel;
 	Graphics::PixelFormat _pixelFormat;
 	Graphics::Surface *_surface;
+	bool _useSSE2;			///< use the SSE2 transforms and motion compensation
 
 	/**
 	 *  Scan patterns shared between indeo4 and indeo5
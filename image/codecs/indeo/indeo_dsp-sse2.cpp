@@ -0,0 +1,486 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// SSE2 versions of the Indeo 4/5 slant transforms, motion compensation and
+// plane output. The transforms work on four rows or columns at once with
+// 32-bit lanes, and the motion compensation averages without widening, so
+// the results are the same as those of the code in indeo_dsp.cpp and
+// indeo.cpp, bit for bit.
+
+#include "common/scummsys.h"
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Image {
+namespace Indeo {
+
+namespace {
+
+FORCEINLINE void transpose4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Transposes an 8x8 block, stored as two vectors per row
+FORCEINLINE void transpose8(__m128i v[8][2]) {
+	transpose4(v[0][0], v[1][0], v[2][0], v[3][0]);
+	transpose4(v[0][1], v[1][1], v[2][1], v[3][1]);
+	transpose4(v[4][0], v[5][0], v[6][0], v[7][0]);
+	transpose4(v[4][1], v[5][1], v[6][1], v[7][1]);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = v[i][1];
+		v[i][1] = v[i + 4][0];
+		v[i + 4][0] = t;
+	}
+}
+
+// All bits set in the lanes of the non-empty columns
+FORCEINLINE __m128i columnMask(const uint8 *flags) {
+	return _mm_set_epi32(flags[3] ? -1 : 0, flags[2] ? -1 : 0, flags[1] ? -1 : 0, flags[0] ? -1 : 0);
+}
+
+// Packs to 16 bits with the wrap-around of a plain int16 assignment
+FORCEINLINE __m128i packTruncate(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+FORCEINLINE __m128i compensate(__m128i x) {
+	return _mm_srai_epi32(_mm_add_epi32(x, _mm_set1_epi32(1)), 1);
+}
+
+// IVI_INV_SLANT8 on four lanes. v[k] holds the k-th input and receives the
+// k-th output.
+template<bool doCompensate>
+FORCEINLINE void invSlant8(__m128i *v) {
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128i four = _mm_set1_epi32(4);
+
+	const __m128i s1 = v[0], s4 = v[1], s8 = v[2], s5 = v[3];
+	const __m128i s2 = v[4], s6 = v[5], s3 = v[6], s7 = v[7];
+
+	// IVI_SLANT_PART4
+	__m128i t4 = _mm_add_epi32(s5, _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(s4, 2), s5), four), 3));
+	__m128i t5 = _mm_add_epi32(s4, _mm_srai_epi32(_mm_sub_epi32(four, _mm_add_epi32(s4, _mm_slli_epi32(s5, 2))), 3));
+
+	__m128i t1 = _mm_add_epi32(s1, t5);
+	t5 = _mm_sub_epi32(s1, t5);
+	__m128i t2 = _mm_add_epi32(s2, s6);
+	__m128i t6 = _mm_sub_epi32(s2, s6);
+	__m128i t7 = _mm_add_epi32(s7, s3);
+	__m128i t3 = _mm_sub_epi32(s7, s3);
+	__m128i t8 = _mm_sub_epi32(t4, s8);
+	t4 = _mm_add_epi32(t4, s8);
+
+	__m128i t = _mm_sub_epi32(t1, t2);
+	t1 = _mm_add_epi32(t1, t2);
+	t2 = t;
+
+	// IVI_IREFLECT
+	t = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(t4, _mm_slli_epi32(t3, 1)), two), 2), t4);
+	t3 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(t4, 1), t3), two), 2), t3);
+	t4 = t;
+
+	t = _mm_sub_epi32(t5, t6);
+	t5 = _mm_add_epi32(t5, t6);
+	t6 = t;
+
+	t = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(t8, _mm_slli_epi32(t7, 1)), two), 2), t8);
+	t7 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(t8, 1), t7), two), 2), t7);
+	t8 = t;
+
+	v[0] = _mm_add_epi32(t1, t4);
+	v[3] = _mm_sub_epi32(t1, t4);
+	v[1] = _mm_add_epi32(t2, t3);
+	v[2] = _mm_sub_epi32(t2, t3);
+	v[4] = _mm_add_epi32(t5, t8);
+	v[7] = _mm_sub_epi32(t5, t8);
+	v[5] = _mm_add_epi32(t6, t7);
+	v[6] = _mm_sub_epi32(t6, t7);
+
+	if (doCompensate) {
+		for (int i = 0; i < 8; i++)
+			v[i] = compensate(v[i]);
+	}
+}
+
+// IVI_INV_SLANT4 on four lanes
+template<bool doCompensate>
+FORCEINLINE void invSlant4(__m128i *v) {
+	const __m128i two = _mm_set1_epi32(2);
+
+	const __m128i s1 = v[0], s4 = v[1], s2 = v[2], s3 = v[3];
+
+	const __m128i t1 = _mm_add_epi32(s1, s2);
+	const __m128i t2 = _mm_sub_epi32(s1, s2);
+	const __m128i t4 = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(s4, _mm_slli_epi32(s3, 1)), two), 2), s4);
+	const __m128i t3 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(s4, 1), s3), two), 2), s3);
+
+	v[0] = _mm_add_epi32(t1, t4);
+	v[3] = _mm_sub_epi32(t1, t4);
+	v[1] = _mm_add_epi32(t2, t3);
+	v[2] = _mm_sub_epi32(t2, t3);
+
+	if (doCompensate) {
+		for (int i = 0; i < 4; i++)
+			v[i] = compensate(v[i]);
+	}
+}
+
+// Loads the eight columns of an 8x8 coefficient block, row by row
+FORCEINLINE void loadBlock8(const int32 *in, __m128i v[8][2]) {
+	for (int i = 0; i < 8; i++) {
+		v[i][0] = _mm_loadu_si128((const __m128i *)(in + i * 8));
+		v[i][1] = _mm_loadu_si128((const __m128i *)(in + i * 8 + 4));
+	}
+}
+
+FORCEINLINE void storeBlock8(int16 *out, uint32 pitch, __m128i v[8][2]) {
+	for (int i = 0; i < 8; i++, out += pitch)
+		_mm_storeu_si128((__m128i *)out, packTruncate(v[i][0], v[i][1]));
+}
+
+// Applies the 8-point transform to both halves of a row-stored block
+template<bool doCompensate>
+FORCEINLINE void invSlant8Columns(__m128i v[8][2]) {
+	__m128i lo[8], hi[8];
+	for (int i = 0; i < 8; i++) {
+		lo[i] = v[i][0];
+		hi[i] = v[i][1];
+	}
+
+	invSlant8<doCompensate>(lo);
+	invSlant8<doCompensate>(hi);
+
+	for (int i = 0; i < 8; i++) {
+		v[i][0] = lo[i];
+		v[i][1] = hi[i];
+	}
+}
+
+FORCEINLINE void maskColumns8(__m128i v[8][2], const uint8 *flags) {
+	const __m128i maskLo = columnMask(flags);
+	const __m128i maskHi = columnMask(flags + 4);
+	for (int i = 0; i < 8; i++) {
+		v[i][0] = _mm_and_si128(v[i][0], maskLo);
+		v[i][1] = _mm_and_si128(v[i][1], maskHi);
+	}
+}
+
+FORCEINLINE __m128i loadPixels8(const int16 *p) {
+	return _mm_loadu_si128((const __m128i *)p);
+}
+
+FORCEINLINE __m128i loadPixels4(const int16 *p) {
+	return _mm_loadl_epi64((const __m128i *)p);
+}
+
+template<int size>
+FORCEINLINE __m128i loadPixels(const int16 *p) {
+	return size == 8 ? loadPixels8(p) : loadPixels4(p);
+}
+
+template<int size>
+FORCEINLINE void storePixels(int16 *p, __m128i v) {
+	if (size == 8)
+		_mm_storeu_si128((__m128i *)p, v);
+	else
+		_mm_storel_epi64((__m128i *)p, v);
+}
+
+// (a + b) >> 1 without overflowing 16 bits
+FORCEINLINE __m128i average2(__m128i a, __m128i b) {
+	const __m128i carry = _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1));
+	return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1), _mm_srai_epi16(b, 1)), carry);
+}
+
+// (a + b + c + d) >> 2 without overflowing 16 bits
+FORCEINLINE __m128i average4(__m128i a, __m128i b, __m128i c, __m128i d) {
+	const __m128i three = _mm_set1_epi16(3);
+	const __m128i high = _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 2), _mm_srai_epi16(b, 2)),
+	                                   _mm_add_epi16(_mm_srai_epi16(c, 2), _mm_srai_epi16(d, 2)));
+	const __m128i low = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(a, three), _mm_and_si128(b, three)),
+	                                  _mm_add_epi16(_mm_and_si128(c, three), _mm_and_si128(d, three)));
+	return _mm_add_epi16(high, _mm_srai_epi16(low, 2));
+}
+
+template<int size, bool add, int mcType>
+FORCEINLINE void mcRows(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch) {
+	for (int i = 0; i < size; i++, buf += dpitch, refBuf += pitch) {
+		__m128i v;
+		if (mcType == 0)
+			v = loadPixels<size>(refBuf);
+		else if (mcType == 1)
+			v = average2(loadPixels<size>(refBuf), loadPixels<size>(refBuf + 1));
+		else if (mcType == 2)
+			v = average2(loadPixels<size>(refBuf), loadPixels<size>(refBuf + pitch));
+		else
+			v = average4(loadPixels<size>(refBuf), loadPixels<size>(refBuf + 1),
+			             loadPixels<size>(refBuf + pitch), loadPixels<size>(refBuf + pitch + 1));
+
+		if (add)
+			v = _mm_add_epi16(loadPixels<size>(buf), v);
+		storePixels<size>(buf, v);
+	}
+}
+
+template<int size, bool add>
+void mc(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	switch (mcType) {
+	case 0:
+		mcRows<size, add, 0>(buf, dpitch, refBuf, pitch);
+		break;
+	case 1:
+		mcRows<size, add, 1>(buf, dpitch, refBuf, pitch);
+		break;
+	case 2:
+		mcRows<size, add, 2>(buf, dpitch, refBuf, pitch);
+		break;
+	case 3:
+		mcRows<size, add, 3>(buf, dpitch, refBuf, pitch);
+		break;
+	default:
+		break;
+	}
+}
+
+template<int size, bool add>
+void mcAvg(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	int16 tmp[size * size];
+
+	mc<size, false>(tmp, size, refBuf, pitch, mcType);
+	mc<size, true>(tmp, size, refBuf2, pitch, mcType2);
+	for (int i = 0; i < size; i++, buf += pitch) {
+		__m128i v = _mm_srai_epi16(loadPixels<size>(tmp + i * size), 1);
+		if (add)
+			v = _mm_add_epi16(loadPixels<size>(buf), v);
+		storePixels<size>(buf, v);
+	}
+}
+
+// Sign extends the low and high four 16-bit values to 32 bits
+FORCEINLINE __m128i widenLo(__m128i v) {
+	return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+FORCEINLINE __m128i widenHi(__m128i v) {
+	return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+// avClipUint8(p + 128) for eight 32-bit values. The values are in the range
+// of an int16 here, so the saturating steps give the same result.
+FORCEINLINE __m128i biasAndClip(__m128i lo, __m128i hi) {
+	const __m128i v = _mm_adds_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(128));
+	return _mm_packus_epi16(v, v);
+}
+
+} // End of anonymous namespace
+
+void IndeoDSP::ffIviInverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i v[8][2];
+
+	loadBlock8(in, v);
+	invSlant8Columns<false>(v);
+	maskColumns8(v, flags);
+
+	transpose8(v);
+	invSlant8Columns<true>(v);
+	transpose8(v);
+
+	storeBlock8(out, pitch, v);
+}
+
+void IndeoDSP::ffIviInverseSlant4x4SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i v[4];
+	for (int i = 0; i < 4; i++)
+		v[i] = _mm_loadu_si128((const __m128i *)(in + i * 4));
+
+	invSlant4<false>(v);
+	const __m128i mask = columnMask(flags);
+	for (int i = 0; i < 4; i++)
+		v[i] = _mm_and_si128(v[i], mask);
+
+	transpose4(v[0], v[1], v[2], v[3]);
+	invSlant4<true>(v);
+	transpose4(v[0], v[1], v[2], v[3]);
+
+	for (int i = 0; i < 4; i++, out += pitch)
+		_mm_storel_epi64((__m128i *)out, packTruncate(v[i], v[i]));
+}
+
+void IndeoDSP::ffIviRowSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i v[8][2];
+
+	loadBlock8(in, v);
+	transpose8(v);
+	invSlant8Columns<true>(v);
+	transpose8(v);
+
+	storeBlock8(out, pitch, v);
+}
+
+void IndeoDSP::ffIviColSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i v[8][2];
+
+	loadBlock8(in, v);
+	invSlant8Columns<true>(v);
+	maskColumns8(v, flags);
+
+	storeBlock8(out, pitch, v);
+}
+
+void IndeoDSP::ffIviMc8x8DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	mc<8, true>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMc4x4DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	mc<4, true>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMc8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	mc<8, false>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMc4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	mc<4, false>(buf, pitch, refBuf, pitch, mcType);
+}
+
+void IndeoDSP::ffIviMcAvg8x8DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	mcAvg<8, true>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+void IndeoDSP::ffIviMcAvg4x4DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	mcAvg<4, true>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+void IndeoDSP::ffIviMcAvg8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	mcAvg<8, false>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+void IndeoDSP::ffIviMcAvg4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	mcAvg<4, false>(buf, refBuf, refBuf2, pitch, mcType, mcType2);
+}
+
+InvTransformPtr *IndeoDSP::getSSE2Transform(InvTransformPtr *transform) {
+	if (transform == ffIviInverseSlant8x8)
+		return ffIviInverseSlant8x8SSE2;
+	if (transform == ffIviInverseSlant4x4)
+		return ffIviInverseSlant4x4SSE2;
+	if (transform == ffIviRowSlant8)
+		return ffIviRowSlant8SSE2;
+	if (transform == ffIviColSlant8)
+		return ffIviColSlant8SSE2;
+	return transform;
+}
+
+int IndeoDSP::outputRowSSE2(const int16 *src, uint8 *dst, int width) {
+	const __m128i bias = _mm_set1_epi16(128);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const __m128i lo = _mm_adds_epi16(loadPixels8(src + x), bias);
+		const __m128i hi = _mm_adds_epi16(loadPixels8(src + x + 8), bias);
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(lo, hi));
+	}
+
+	for (; x + 8 <= width; x += 8) {
+		const __m128i v = _mm_adds_epi16(loadPixels8(src + x), bias);
+		_mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(v, v));
+	}
+
+	return x;
+}
+
+int IndeoDSP::recomposeHaarRowSSE2(const int16 *b0Ptr, const int16 *b1Ptr, const int16 *b2Ptr, const int16 *b3Ptr,
+		uint8 *dst, int dstPitch, int width) {
+	const __m128i two = _mm_set1_epi32(2);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const int indx = x >> 1;
+		const __m128i v0 = loadPixels8(b0Ptr + indx);
+		const __m128i v1 = loadPixels8(b1Ptr + indx);
+		const __m128i v2 = loadPixels8(b2Ptr + indx);
+		const __m128i v3 = loadPixels8(b3Ptr + indx);
+
+		__m128i p[4][2];
+		for (int h = 0; h < 2; h++) {
+			const __m128i b0 = h ? widenHi(v0) : widenLo(v0);
+			const __m128i b1 = h ? widenHi(v1) : widenLo(v1);
+			const __m128i b2 = h ? widenHi(v2) : widenLo(v2);
+			const __m128i b3 = h ? widenHi(v3) : widenLo(v3);
+
+			const __m128i sum01 = _mm_add_epi32(_mm_add_epi32(b0, b1), two);
+			const __m128i dif01 = _mm_add_epi32(_mm_sub_epi32(b0, b1), two);
+			const __m128i sum23 = _mm_add_epi32(b2, b3);
+			const __m128i dif23 = _mm_sub_epi32(b2, b3);
+
+			p[0][h] = _mm_srai_epi32(_mm_add_epi32(sum01, sum23), 2);
+			p[1][h] = _mm_srai_epi32(_mm_sub_epi32(sum01, sum23), 2);
+			p[2][h] = _mm_srai_epi32(_mm_add_epi32(dif01, dif23), 2);
+			p[3][h] = _mm_srai_epi32(_mm_sub_epi32(dif01, dif23), 2);
+		}
+
+		const __m128i p0 = biasAndClip(p[0][0], p[0][1]);
+		const __m128i p1 = biasAndClip(p[1][0], p[1][1]);
+		const __m128i p2 = biasAndClip(p[2][0], p[2][1]);
+		const __m128i p3 = biasAndClip(p[3][0], p[3][1]);
+
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_unpacklo_epi8(p0, p1));
+		_mm_storeu_si128((__m128i *)(dst + dstPitch + x), _mm_unpacklo_epi8(p2, p3));
+	}
+
+	return x;
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -327,6 +327,46 @@ public:
 	 *  @param[in]      mcType2		Interpolation type for forward reference
 	 */
 	static void ffIviMcAvg4x4NoDelta(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+
+#ifdef SCUMMVM_SSE2
+	// SSE2 versions of the functions above, which give exactly the same results
+	static void ffIviInverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviInverseSlant4x4SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviRowSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	static void ffIviColSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+
+	static void ffIviMc8x8DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc4x4DeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMcAvg8x8DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg4x4DeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg8x8NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg4x4NoDeltaSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+
+	/**
+	 *  Return the SSE2 version of an inverse transform, or the transform
+	 *  itself if there is none.
+	 */
+	static InvTransformPtr *getSSE2Transform(InvTransformPtr *transform);
+
+	/**
+	 *  Bias and clip the start of a row of a plane, like
+	 *  IndeoDecoderBase::outputPlane().
+	 *
+	 *  @returns	The number of pixels converted
+	 */
+	static int outputRowSSE2(const int16 *src, uint8 *dst, int width);
+
+	/**
+	 *  Recompose the start of a pair of rows from the four Haar wavelet
+	 *  bands, like IndeoDecoderBase::recomposeHaar().
+	 *
+	 *  @returns	The number of pixels converted in each row
+	 */
+	static int recomposeHaarRowSSE2(const int16 *b0Ptr, const int16 *b1Ptr, const int16 *b2Ptr,
+		const int16 *b3Ptr, uint8 *dst, int dstPitch, int width);
+#endif
 };
 
 } // End of namespace Indeo
@@ -237,15 +237,22 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
 
 	uint32 dataSize = stream.size() - hPos;
 
-	byte *inData = new byte[dataSize];
+	byte *inBuffer = nullptr;
+	const byte *inData = stream.getContiguousData(hPos, dataSize);
 
-	if (stream.read(inData, dataSize) != dataSize) {
-		delete[] inData;
-		return 0;
+	if (!inData) {
+		inBuffer = new byte[dataSize];
+
+		if (stream.read(inBuffer, dataSize) != dataSize) {
+			delete[] inBuffer;
+			return 0;
+		}
+
+		inData = inBuffer;
 	}
 
-	byte *hdr_pos = inData;
-	byte *buf_pos;
+	const byte *hdr_pos = inData;
+	const byte *buf_pos;
 
 	// Luminance Y
 	stream.seek(offsY);
@@ -268,7 +275,7 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
 	decodeChunk(_cur_frame->Ubuf, _ref_frame->Ubuf, chromaWidth, chromaHeight,
 			buf_pos + offs * 2, flags2, hdr_pos, buf_pos, MIN<int>(chromaWidth, 40));
 
-	delete[] inData;
+	delete[] inBuffer;
 
 	const byte *srcY = _cur_frame->Ybuf;
 	const byte *srcU = _cur_frame->Ubuf;
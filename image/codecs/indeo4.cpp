@@ -69,11 +69,17 @@ const Graphics::Surface *Indeo4Decoder::decodeFrame(Common::SeekableReadStream &
 	if (!isIndeo4(stream))
 		return nullptr;
 
-	// Set up the frame data buffer
-	byte *frameData = new byte[stream.size()];
-	stream.read(frameData, stream.size());
+	// Set up the frame data buffer, unless the frame is already in memory
+	uint32 frameSize = stream.size();
+	byte *frameBuffer = nullptr;
+	const byte *frameData = stream.getContiguousData(stream.pos(), frameSize);
+	if (!frameData) {
+		frameBuffer = new byte[frameSize];
+		stream.read(frameBuffer, frameSize);
+		frameData = frameBuffer;
+	}
 	_ctx._frameData = frameData;
-	_ctx._frameSize = stream.size();
+	_ctx._frameSize = frameSize;
 
 	// Set up the GetBits instance for reading the data
 	_ctx._gb = new GetBits(_ctx._frameData, _ctx._frameSize);
@@ -84,7 +90,7 @@ const Graphics::Surface *Indeo4Decoder::decodeFrame(Common::SeekableReadStream &
 	// Free the bit reader and frame buffer
 	delete _ctx._gb;
 	_ctx._gb = nullptr;
-	delete[] frameData;
+	delete[] frameBuffer;
 	_ctx._frameData = nullptr;
 	_ctx._frameSize = 0;
 
@@ -347,6 +353,11 @@ int Indeo4Decoder::decodeBandHeader(IVIBandDesc *band) {
 			band->_dcTransform = _transforms[transformId]._dcTrans;
 			band->_is2dTrans = _transforms[transformId]._is2dTrans;
 
+#ifdef SCUMMVM_SSE2
+			if (_useSSE2)
+				band->_invTransform = IndeoDSP::getSSE2Transform(band->_invTransform);
+#endif
+
 			if (transformId < 10)
 				band->_transformSize = 8;
 			else
@@ -77,11 +77,17 @@ const Graphics::Surface *Indeo5Decoder::decodeFrame(Common::SeekableReadStream &
 	if (!isIndeo5(stream))
 		return nullptr;
 
-	// Set up the frame data buffer
-	byte *frameData = new byte[stream.size()];
-	stream.read(frameData, stream.size());
+	// Set up the frame data buffer, unless the frame is already in memory
+	uint32 frameSize = stream.size();
+	byte *frameBuffer = nullptr;
+	const byte *frameData = stream.getContiguousData(stream.pos(), frameSize);
+	if (!frameData) {
+		frameBuffer = new byte[frameSize];
+		stream.read(frameBuffer, frameSize);
+		frameData = frameBuffer;
+	}
 	_ctx._frameData = frameData;
-	_ctx._frameSize = stream.size();
+	_ctx._frameSize = frameSize;
 
 	// Set up the GetBits instance for reading the data
 	_ctx._gb = new GetBits(_ctx._frameData, _ctx._frameSize);
@@ -92,7 +98,7 @@ const Graphics::Surface *Indeo5Decoder::decodeFrame(Common::SeekableReadStream &
 	// Free the bit reader and frame buffer
 	delete _ctx._gb;
 	_ctx._gb = nullptr;
-	delete[] frameData;
+	delete[] frameBuffer;
 	_ctx._frameData = nullptr;
 	_ctx._frameSize = 0;
 
@@ -525,6 +531,11 @@ int Indeo5Decoder::decode_gop_header() {
 			band->_is2dTrans = band->_invTransform == IndeoDSP::ffIviInverseSlant8x8 ||
 				band->_invTransform == IndeoDSP::ffIviInverseSlant4x4;
 
+#ifdef SCUMMVM_SSE2
+			if (_useSSE2)
+				band->_invTransform = IndeoDSP::getSSE2Transform(band->_invTransform);
+#endif
+
 			if (band->_transformSize != band->_blkSize) {
 				warning("transform and block size mismatch (%d != %d)", band->_transformSize, band->_blkSize);
 				return -1;
@@ -92,6 +92,7 @@ TrueMotion1Decoder::TrueMotion1Decoder() {
 	_surface = 0;
 	_vertPred = 0;
 
+	_ownedBuf = 0;
 	_buf = _mbChangeBits = _indexStream = 0;
 	_lastDeltaset = _lastVectable = -1;
 }
@@ -160,8 +161,14 @@ void TrueMotion1Decoder::genVectorTable16(const byte *selVectorTable) {
 }
 
 void TrueMotion1Decoder::decodeHeader(Common::SeekableReadStream &stream) {
-	_buf = new byte[stream.size()];
-	stream.read(_buf, stream.size());
+	// Only copy the frame if it is not in memory already
+	_ownedBuf = 0;
+	_buf = stream.getContiguousData(stream.pos(), stream.size());
+	if (!_buf) {
+		_ownedBuf = new byte[stream.size()];
+		stream.read(_ownedBuf, stream.size());
+		_buf = _ownedBuf;
+	}
 
 	byte headerBuffer[128];  // logical maximum size of the header
 	const byte *selVectorTable;
@@ -410,18 +417,18 @@ const Graphics::Surface *TrueMotion1Decoder::decodeFrame(Common::SeekableReadStr
 	decodeHeader(stream);
 
 	if (compressionTypes[_header.compression].algorithm == ALGO_NOP) {
-		delete[] _buf;
+		delete[] _ownedBuf;
 		return 0;
 	}
 
 	if (compressionTypes[_header.compression].algorithm == ALGO_RGB24H) {
 		warning("Unhandled TrueMotion1 24bpp frame");
-		delete[] _buf;
+		delete[] _ownedBuf;
 		return 0;
 	} else
 		decode16();
 
-	delete[] _buf;
+	delete[] _ownedBuf;
 
 	return _surface;
 }
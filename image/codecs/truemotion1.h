@@ -50,7 +50,8 @@ private:
 	Graphics::Surface *_surface;
 
 	int _mbChangeBitsRowSize;
-	byte *_buf, *_mbChangeBits, *_indexStream;
+	byte *_ownedBuf;
+	const byte *_buf, *_mbChangeBits, *_indexStream;
 	int _indexStreamSize;
 
 	int _flags;
@@ -55,6 +55,10 @@ MODULE_OBJS += \
 	codecs/indeo/indeo_dsp.o \
 	codecs/indeo/mem.o \
 	codecs/indeo/vlc.o
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-sse2.o
+endif
 endif
 
 ifdef USE_HNM
@@ -0,0 +1,83 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+
+#include "backends/fs/posix/posix-mmapstream.h"
+
+class PosixMmapStreamTestSuite : public CxxTest::TestSuite {
+public:
+	void test_read_and_seek() {
+#ifdef HAS_MMAP
+		const uint32 size = 100000;
+		byte data[size];
+		for (uint32 i = 0; i < size; i++)
+			data[i] = (byte)(i * 13 + (i >> 8));
+
+		Common::FSNode node(Common::Path("test/mmapstream.dat"));
+		Common::ScopedPtr<Common::SeekableWriteStream> out(node.createWriteStream(false));
+		TS_ASSERT(out);
+		if (!out)
+			return;
+		TS_ASSERT_EQUALS(out->write(data, size), size);
+		out.reset();
+
+		// Mapping is off by default
+		Common::ScopedPtr<Common::SeekableReadStream> s(node.createReadStream());
+		TS_ASSERT(s);
+		TS_ASSERT(s && !s->getContiguousData(0, size));
+
+		PosixMmapStream::setThreshold(size + 1);
+		s.reset(node.createReadStream());
+		TS_ASSERT(s && !s->getContiguousData(0, size));
+
+		PosixMmapStream::setThreshold(size);
+		s.reset(node.createReadStream());
+		PosixMmapStream::setThreshold(0);
+		TS_ASSERT(s);
+		if (!s)
+			return;
+
+		const byte *mapped = s->getContiguousData(0, size);
+		TS_ASSERT(mapped);
+		TS_ASSERT(mapped && memcmp(mapped, data, size) == 0);
+		TS_ASSERT(!s->getContiguousData(1, size));
+		TS_ASSERT_EQUALS(s->size(), (int64)size);
+
+		// Read through the file in uneven chunks
+		byte buf[777];
+		uint32 pos = 0;
+		while (pos < size) {
+			uint32 len = s->read(buf, sizeof(buf));
+			TS_ASSERT(len == MIN<uint32>(sizeof(buf), size - pos));
+			TS_ASSERT(memcmp(buf, data + pos, len) == 0);
+			pos += len;
+		}
+		TS_ASSERT(s->eos());
+		TS_ASSERT(!s->err());
+
+		// Seeking clears the end of stream flag
+		TS_ASSERT(s->seek(-1000, SEEK_CUR));
+		TS_ASSERT(!s->eos());
+		TS_ASSERT_EQUALS(s->pos(), (int64)size - 1000);
+		TS_ASSERT_EQUALS(s->readByte(), data[size - 1000]);
+
+		TS_ASSERT(s->seek(12345));
+		TS_ASSERT_EQUALS(s->read(buf, 100), 100U);
+		TS_ASSERT(memcmp(buf, data + 12345, 100) == 0);
+
+		TS_ASSERT(s->seek(-10, SEEK_END));
+		TS_ASSERT_EQUALS(s->read(buf, 100), 10U);
+		TS_ASSERT(memcmp(buf, data + size - 10, 10) == 0);
+		TS_ASSERT(s->eos());
+
+		// Seeks out of the file fail and keep the position
+		TS_ASSERT(s->seek(5));
+		TS_ASSERT(!s->seek(-1));
+		TS_ASSERT(!s->seek(size + 1));
+		TS_ASSERT_EQUALS(s->pos(), 5);
+		TS_ASSERT_EQUALS(s->readByte(), data[5]);
+#endif
+	}
+};
@@ -0,0 +1,96 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite
+{
+	struct Item {
+		int a;
+		uint16 b;
+		Item(int a_, uint16 b_) : a(a_), b(b_) {}
+	};
+
+	public:
+	void test_allocate() {
+		Common::Arena arena(256);
+		TS_ASSERT_EQUALS(arena.getBytesUsed(), 0U);
+		TS_ASSERT_EQUALS(arena.getBytesReserved(), 0U);
+
+		byte *first = (byte *)arena.allocate(3, 1);
+		byte *second = (byte *)arena.allocate(5, 1);
+		TS_ASSERT_EQUALS(second, first + 3);
+
+		uint32 *aligned = (uint32 *)arena.allocate(sizeof(uint32), 4);
+		TS_ASSERT_EQUALS((uintptr)aligned & 3, 0U);
+		*aligned = 0x12345678;
+
+		uint64 *values = arena.allocateArray<uint64>(4);
+		TS_ASSERT_EQUALS((uintptr)values & (alignof(uint64) - 1), 0U);
+		values[3] = 1;
+		TS_ASSERT_EQUALS(*aligned, 0x12345678U);
+		TS_ASSERT_EQUALS(arena.getBytesReserved(), 256U);
+	}
+
+	void test_new_objects() {
+		Common::Arena arena(64);
+		Item *items[100];
+		for (int i = 0; i < 100; i++)
+			items[i] = new (arena) Item(i, i * 3);
+
+		// Blocks fill up, but earlier objects stay in place
+		TS_ASSERT(arena.getBytesReserved() > 64U);
+		for (int i = 0; i < 100; i++) {
+			TS_ASSERT_EQUALS(items[i]->a, i);
+			TS_ASSERT_EQUALS(items[i]->b, i * 3);
+		}
+	}
+
+	void test_large_allocation() {
+		Common::Arena arena(64);
+		arena.allocate(16);
+		byte *large = (byte *)arena.allocate(1000);
+		memset(large, 1, 1000);
+		TS_ASSERT(arena.getBytesReserved() >= 1064U);
+
+		// Small allocations continue in the large block
+		byte *small = (byte *)arena.allocate(4, 4);
+		TS_ASSERT_EQUALS(small, large + 1000);
+	}
+
+	void test_rewind() {
+		Common::Arena arena(64);
+		void *first = arena.allocate(8);
+
+		Common::Arena::Mark mark = arena.getMark();
+		void *second = arena.allocate(8);
+		for (int i = 0; i < 20; i++)
+			arena.allocate(8);
+		const size_t reserved = arena.getBytesReserved();
+
+		arena.rewind(mark);
+		TS_ASSERT_EQUALS(arena.allocate(8), second);
+
+		// Blocks are reused after a reset
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getBytesUsed(), 0U);
+		TS_ASSERT_EQUALS(arena.allocate(8), first);
+		for (int i = 0; i < 21; i++)
+			arena.allocate(8);
+		TS_ASSERT_EQUALS(arena.getBytesReserved(), reserved);
+
+		arena.freeBlocks();
+		TS_ASSERT_EQUALS(arena.getBytesReserved(), 0U);
+	}
+
+	void test_scoped_mark() {
+		Common::Arena arena;
+		arena.allocate(16);
+		const size_t used = arena.getBytesUsed();
+		{
+			Common::ScopedArenaMark scope(arena);
+			arena.allocateArray<int>(100);
+			TS_ASSERT(arena.getBytesUsed() > used);
+		}
+		TS_ASSERT_EQUALS(arena.getBytesUsed(), used);
+	}
+};
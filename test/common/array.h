@@ -1,8 +1,13 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/array.h"
+#include "common/debug.h"
 #include "common/noncopyable.h"
+#include "common/rect.h"
 #include "common/str.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
 
 
 struct ArrayTestMovable {
@@ -517,6 +522,121 @@ class ArrayTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(array2[2], 17);
 	}
 
+	void test_small_array_inline() {
+		Common::SmallArray<int, 4> array;
+		TS_ASSERT(array.empty());
+		TS_ASSERT(array.isInline());
+
+		for (int i = 0; i < 4; i++)
+			array.push_back(i * 10);
+		TS_ASSERT(array.isInline());
+		TS_ASSERT_EQUALS(array.size(), 4U);
+
+		// Growing past the inline storage keeps the elements
+		array.push_back(40);
+		TS_ASSERT(!array.isInline());
+		for (int i = 0; i < 5; i++)
+			TS_ASSERT_EQUALS(array[i], i * 10);
+
+		array.insert_at(1, 5);
+		TS_ASSERT_EQUALS(array[0], 0);
+		TS_ASSERT_EQUALS(array[1], 5);
+		TS_ASSERT_EQUALS(array[2], 10);
+		TS_ASSERT_EQUALS(array.back(), 40);
+
+		TS_ASSERT_EQUALS(array.remove_at(1), 5);
+		TS_ASSERT_EQUALS(array[1], 10);
+		TS_ASSERT_EQUALS(array.size(), 5U);
+
+		array.clear();
+		TS_ASSERT(array.empty());
+		TS_ASSERT(array.isInline());
+	}
+
+	void test_small_array_copy_move() {
+		Common::SmallArray<Common::String, 2> array;
+		array.push_back("short");
+		array.push_back("a string which is too long for the internal storage of a string");
+
+		Common::SmallArray<Common::String, 2> copy(array);
+		TS_ASSERT(copy == array);
+
+		// Moving inline elements one by one
+		Common::SmallArray<Common::String, 2> moved(Common::move(copy));
+		TS_ASSERT(moved == array);
+		TS_ASSERT(copy.empty());
+
+		// Moving heap storage
+		moved.push_back("third");
+		const Common::String *storage = moved.data();
+		Common::SmallArray<Common::String, 2> moved2;
+		moved2 = Common::move(moved);
+		TS_ASSERT_EQUALS(moved2.data(), storage);
+		TS_ASSERT_EQUALS(moved2.size(), 3U);
+		TS_ASSERT(moved.empty());
+		TS_ASSERT(moved.isInline());
+
+		copy = moved2;
+		TS_ASSERT(copy == moved2);
+		copy.resize(1);
+		TS_ASSERT_EQUALS(copy[0], "short");
+	}
+
+	void test_small_array_emplace() {
+		Common::SmallArray<ArrayTestMovable, 1> array;
+		array.emplace_back(1);
+		array.emplace_back(2);
+
+		// Growing moved the first element rather than copying it
+		TS_ASSERT_EQUALS(array[0]._value, 1);
+		TS_ASSERT(array[0]._wasMoveConstructed);
+		TS_ASSERT_EQUALS(array[1]._value, 2);
+		TS_ASSERT(!array[1]._wasMoveConstructed);
+
+		// Appending one of the elements while growing
+		Common::SmallArray<Common::String, 2> strings;
+		strings.push_back("a string which is too long for the internal storage of a string");
+		strings.push_back("b");
+		strings.push_back(strings[0]);
+		TS_ASSERT_EQUALS(strings[2], strings[0]);
+	}
+
+	void test_small_array_speed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Compare building many small temporary arrays with Array
+#ifdef SLOW_TESTS
+		const int iters = 1000000;
+#else
+		const int iters = 1000;
+#endif
+		int arraySum = 0, smallSum = 0;
+
+		uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			Common::Array<Common::Rect> rects;
+			for (int i = 0; i < 6; i++)
+				rects.push_back(Common::Rect(i, n & 15, i + 10, 20));
+			for (uint i = 0; i < rects.size(); i++)
+				arraySum += rects[i].width();
+		}
+		uint32 arrayTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			Common::SmallArray<Common::Rect, 8> rects;
+			for (int i = 0; i < 6; i++)
+				rects.emplace_back(i, n & 15, i + 10, 20);
+			for (uint i = 0; i < rects.size(); i++)
+				smallSum += rects[i].width();
+		}
+		uint32 smallTime = g_system->getMillis() - start;
+
+		debug("%d small arrays: Array %d ms, SmallArray %d ms", iters, arrayTime, smallTime);
+		TS_ASSERT_EQUALS(arraySum, smallSum);
+#endif
+	}
 };
 
 struct ListElement {
@@ -0,0 +1,242 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/compression/deflate.h"
+#include "common/compression/unzip.h"
+#include "common/crc.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+/**
+ * Builds small zipfiles in memory, so that both the in-memory and the
+ * streaming code paths for members can be exercised.
+ */
+class UnzipTestSuite : public CxxTest::TestSuite {
+	struct Member {
+		const char *name;
+		uint16 method;
+		uint32 crc;
+		uint32 size;
+		Common::Array<byte> data; // As stored in the zipfile
+		uint32 offset;
+	};
+
+	static void fillPattern(Common::Array<byte> &buf, uint32 size) {
+		buf.resize(size);
+		for (uint32 i = 0; i < size; i++)
+			buf[i] = (byte)(i * 7 + (i >> 11));
+	}
+
+	// Wrap the data into uncompressed deflate blocks
+	static void storeDeflate(Common::Array<byte> &out, const Common::Array<byte> &in) {
+		uint32 pos = 0;
+		do {
+			uint32 len = MIN<uint32>(in.size() - pos, 0xFFFF);
+			out.push_back(pos + len == in.size() ? 1 : 0);
+			out.push_back(len & 0xFF);
+			out.push_back(len >> 8);
+			out.push_back(~len & 0xFF);
+			out.push_back((~len >> 8) & 0xFF);
+			for (uint32 i = 0; i < len; i++)
+				out.push_back(in[pos + i]);
+			pos += len;
+		} while (pos < in.size());
+	}
+
+	// Really compress the data, falling back to stored blocks without zlib
+	static void compressDeflate(Common::Array<byte> &out, const Common::Array<byte> &in) {
+		Common::MemoryWriteStreamDynamic *buf = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gz = Common::wrapCompressedWriteStream(buf);
+		gz->write(in.data(), in.size());
+		gz->finalize();
+		byte *data = buf->getData();
+		uint32 size = buf->size();
+		delete gz; // Also deletes buf, when it was wrapped
+
+		// Strip the gzip header and trailer to get raw deflate data
+		if (size > 18 && data[0] == 0x1F && data[1] == 0x8B && data[3] == 0)
+			out = Common::Array<byte>(data + 10, size - 18);
+		else
+			storeDeflate(out, in);
+		free(data);
+	}
+
+	static void addMember(Common::Array<Member> &members, const char *name, uint16 method, const Common::Array<byte> &content, bool compress = false) {
+		Member m;
+		m.name = name;
+		m.method = method;
+		m.crc = Common::CRC32().crcFast(content.data(), content.size());
+		m.size = content.size();
+		if (method == 8 && compress)
+			compressDeflate(m.data, content);
+		else if (method == 8)
+			storeDeflate(m.data, content);
+		else
+			m.data = content;
+		m.offset = 0;
+		members.push_back(m);
+	}
+
+	static Common::Archive *buildZip(Common::Array<Member> &members) {
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+
+		for (uint i = 0; i < members.size(); i++) {
+			Member &m = members[i];
+			uint16 nameLen = strlen(m.name);
+			m.offset = out->pos();
+			out->writeUint32LE(0x04034b50);
+			out->writeUint16LE(20);
+			out->writeUint16LE(0);
+			out->writeUint16LE(m.method);
+			out->writeUint16LE(0);
+			out->writeUint16LE(0x21);
+			out->writeUint32LE(m.crc);
+			out->writeUint32LE(m.data.size());
+			out->writeUint32LE(m.size);
+			out->writeUint16LE(nameLen);
+			out->writeUint16LE(0);
+			out->write(m.name, nameLen);
+			out->write(m.data.data(), m.data.size());
+		}
+
+		uint32 centralDir = out->pos();
+		for (uint i = 0; i < members.size(); i++) {
+			const Member &m = members[i];
+			uint16 nameLen = strlen(m.name);
+			out->writeUint32LE(0x02014b50);
+			out->writeUint16LE(20);
+			out->writeUint16LE(20);
+			out->writeUint16LE(0);
+			out->writeUint16LE(m.method);
+			out->writeUint16LE(0);
+			out->writeUint16LE(0x21);
+			out->writeUint32LE(m.crc);
+			out->writeUint32LE(m.data.size());
+			out->writeUint32LE(m.size);
+			out->writeUint16LE(nameLen);
+			out->writeUint16LE(0);
+			out->writeUint16LE(0);
+			out->writeUint16LE(0);
+			out->writeUint16LE(0);
+			out->writeUint32LE(0);
+			out->writeUint32LE(m.offset);
+			out->write(m.name, nameLen);
+		}
+		uint32 centralDirSize = out->pos() - centralDir;
+
+		out->writeUint32LE(0x06054b50);
+		out->writeUint16LE(0);
+		out->writeUint16LE(0);
+		out->writeUint16LE(members.size());
+		out->writeUint16LE(members.size());
+		out->writeUint32LE(centralDirSize);
+		out->writeUint32LE(centralDir);
+		out->writeUint16LE(0);
+
+		uint32 size = out->size();
+		byte *data = out->getData();
+		delete out;
+
+		return Common::makeZipArchive(new Common::MemoryReadStream(data, size, DisposeAfterUse::YES));
+	}
+
+	static bool checkContents(Common::SeekableReadStream *stream, const Common::Array<byte> &expected) {
+		if (!stream || stream->size() != (int64)expected.size())
+			return false;
+
+		Common::Array<byte> buf;
+		buf.resize(expected.size());
+		if (stream->read(buf.data(), buf.size()) != buf.size())
+			return false;
+		return buf == expected;
+	}
+
+public:
+	void test_small_and_large_members() {
+		Common::Array<byte> small, large;
+		fillPattern(small, 1000);
+		fillPattern(large, 3 * 1024 * 1024 + 17);
+
+		Common::Array<Member> members;
+		addMember(members, "small.bin", 0, small);
+		addMember(members, "smalldeflate.bin", 8, small);
+		addMember(members, "large.bin", 0, large);
+		addMember(members, "largedeflate.bin", 8, large);
+
+		Common::Archive *zip = buildZip(members);
+		TS_ASSERT(zip != nullptr);
+		if (!zip)
+			return;
+
+		Common::ScopedPtr<Common::SeekableReadStream> s;
+
+		s.reset(zip->createReadStreamForMember("small.bin"));
+		TS_ASSERT(checkContents(s.get(), small));
+		s.reset(zip->createReadStreamForMember("smalldeflate.bin"));
+		TS_ASSERT(checkContents(s.get(), small));
+		s.reset(zip->createReadStreamForMember("large.bin"));
+		TS_ASSERT(checkContents(s.get(), large));
+		s.reset(zip->createReadStreamForMember("largedeflate.bin"));
+		TS_ASSERT(checkContents(s.get(), large));
+
+		// Streamed members must stay usable after the archive is gone,
+		// including seeking both ways
+		Common::ScopedPtr<Common::SeekableReadStream> stored(zip->createReadStreamForMember("large.bin"));
+		Common::ScopedPtr<Common::SeekableReadStream> deflated(zip->createReadStreamForMember("largedeflate.bin"));
+		delete zip;
+
+		TS_ASSERT(stored);
+		TS_ASSERT(deflated);
+		if (!stored || !deflated)
+			return;
+
+		const uint32 offsets[] = { 2 * 1024 * 1024 + 5, 123, (uint32)large.size() - 1 };
+		for (uint i = 0; i < ARRAYSIZE(offsets); i++) {
+			TS_ASSERT(stored->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stored->readByte(), large[offsets[i]]);
+			TS_ASSERT(deflated->seek(offsets[i]));
+			TS_ASSERT_EQUALS(deflated->readByte(), large[offsets[i]]);
+		}
+
+		stored->readByte();
+		TS_ASSERT(stored->eos());
+		TS_ASSERT(!stored->err());
+	}
+
+	void test_streamed_seeks() {
+		Common::Array<byte> large;
+		fillPattern(large, 5 * 1024 * 1024 + 321);
+
+		Common::Array<Member> members;
+		addMember(members, "compressed.bin", 8, large, true);
+		Common::ScopedPtr<Common::Archive> zip(buildZip(members));
+		TS_ASSERT(zip);
+		if (!zip)
+			return;
+
+		Common::ScopedPtr<Common::SeekableReadStream> s(zip->createReadStreamForMember("compressed.bin"));
+		TS_ASSERT(checkContents(s.get(), large));
+		if (!s)
+			return;
+
+		// Seek around the stream, mostly backwards, in front of, on and
+		// behind the points decompression can be resumed from
+		const uint32 offsets[] = {
+			(uint32)large.size() - 1000, 4 * 1024 * 1024 + 1, 1024 * 1024, 1024 * 1024 - 1,
+			3 * 1024 * 1024 + 77777, 12345, 2 * 1024 * 1024 + 999, 0, (uint32)large.size() - 1000
+		};
+		byte buf[1000];
+		for (uint i = 0; i < ARRAYSIZE(offsets); i++) {
+			TS_ASSERT(s->seek(offsets[i]));
+			TS_ASSERT_EQUALS(s->pos(), offsets[i]);
+			TS_ASSERT_EQUALS(s->read(buf, sizeof(buf)), sizeof(buf));
+			TS_ASSERT(memcmp(buf, large.data() + offsets[i], sizeof(buf)) == 0);
+		}
+
+		TS_ASSERT(s->seek(-10, SEEK_END));
+		TS_ASSERT_EQUALS(s->read(buf, sizeof(buf)), 10U);
+		TS_ASSERT(memcmp(buf, large.data() + large.size() - 10, 10) == 0);
+		TS_ASSERT(s->eos());
+		TS_ASSERT(!s->err());
+	}
+};
@@ -0,0 +1,19 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/file.h"
+#include "common/memstream.h"
+
+class FileTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_contiguous_data() {
+		static const byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+
+		// Files pass on direct access to the data of their handle
+		Common::File file;
+		TS_ASSERT(file.open(new Common::MemoryReadStream(contents, sizeof(contents)), "contents"));
+		TS_ASSERT_EQUALS(file.getContiguousData(0, 7), contents);
+		TS_ASSERT_EQUALS(file.getContiguousData(3, 2), contents + 3);
+		TS_ASSERT(!file.getContiguousData(3, 5));
+		TS_ASSERT_EQUALS(file.pos(), 0);
+	}
+};
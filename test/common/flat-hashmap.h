@@ -0,0 +1,249 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/flat-hashmap.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+#include "../null_osystem.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+
+	// Counts how many keys lookups compare, to tell how long the probe sequences are
+	struct CountingEqualTo {
+		static uint &calls() {
+			static uint count = 0;
+			return count;
+		}
+		bool operator()(int x, int y) const {
+			calls()++;
+			return x == y;
+		}
+	};
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		FlatStringMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear();
+		TS_ASSERT(container2.empty());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		FlatStringMap container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(0));
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		container.erase(2);
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(4));
+		TS_ASSERT(container.empty());
+		container[1] = 33;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT_EQUALS(container.size(), 1U);
+	}
+
+	void test_lookup() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container.setVal(2, 45);
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef[0], 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(1), -1);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(2), 45);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+
+		int val = 0;
+		TS_ASSERT(containerRef.tryGetVal(2, val));
+		TS_ASSERT_EQUALS(val, 45);
+		TS_ASSERT(!containerRef.tryGetVal(3, val));
+		TS_ASSERT_EQUALS(containerRef.find(3), containerRef.end());
+	}
+
+	void test_grow_and_erase() {
+		// Enough entries for several rehashes, with erased slots in between
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 5000; i++)
+			container[i * 7] = i;
+		for (int i = 0; i < 5000; i += 2)
+			container.erase(i * 7);
+		for (int i = 5000; i < 6000; i++)
+			container[i * 7] = i;
+
+		TS_ASSERT_EQUALS(container.size(), 3500U);
+		for (int i = 0; i < 6000; i++) {
+			if (i < 5000 && !(i & 1)) {
+				TS_ASSERT(!container.contains(i * 7));
+			} else {
+				TS_ASSERT_EQUALS(container.getValOrDefault(i * 7, -1), i);
+			}
+		}
+
+		// Repeated insertion and removal must not grow the map forever
+		for (int i = 0; i < 100000; i++) {
+			container[-1 - i] = i;
+			container.erase(-1 - i);
+		}
+		TS_ASSERT_EQUALS(container.size(), 3500U);
+	}
+
+	void test_copy() {
+		FlatStringMap map1, map2;
+		for (int i = 0; i < 100; i++)
+			map1[Common::String::format("key%d", i)] = Common::String::format("a rather long value for entry %d", i);
+		map1.erase("key50");
+
+		map2 = map1;
+		FlatStringMap map3(map2);
+		map1.clear(true);
+
+		TS_ASSERT_EQUALS(map3.size(), 99U);
+		TS_ASSERT(!map3.contains("key50"));
+		TS_ASSERT_EQUALS(map3["key99"], "a rather long value for entry 99");
+		TS_ASSERT_EQUALS(map2["KEY0"], "a rather long value for entry 0");
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		// Erasing the current entry while iterating
+		for (i = container.begin(); i != container.end(); ++i) {
+			if (i->_key == 3)
+				container.erase(i);
+		}
+
+		found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = container.begin(); j != container.end(); ++j)
+			found |= 1 << j->_key;
+		TS_ASSERT(found == 16+4);
+	}
+
+	void test_high_bit_keys() {
+		// Common::Hash<int> is the identity, so these keys only differ in
+		// bits above the ones used to index the table
+		Common::FlatHashMap<int, int, Common::Hash<int>, CountingEqualTo> container;
+		const int count = 4096;
+		for (int i = 0; i < count; i++)
+			container[i << 16] = i;
+		TS_ASSERT_EQUALS(container.size(), (uint)count);
+
+		CountingEqualTo::calls() = 0;
+		for (int i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(container.getValOrDefault(i << 16, -1), i);
+		for (int i = count; i < 2 * count; i++)
+			TS_ASSERT(!container.contains(i << 16));
+
+		// With the keys spread over the table, a lookup compares little more
+		// than the key it is looking for, instead of probing one long run
+		TS_ASSERT_LESS_THAN(CountingEqualTo::calls(), (uint)count * 5 / 4);
+	}
+
+	void test_lookup_speed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Compare lookups with HashMap
+#ifdef SLOW_TESTS
+		const int iters = 200;
+#else
+		const int iters = 1;
+#endif
+		const int count = 10000;
+		Common::StringArray keys;
+		for (int i = 0; i < count; i++)
+			keys.push_back(Common::String::format("resource_%d.bin", i));
+
+		Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> hashMap;
+		Common::FlatHashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> flatMap;
+		for (int i = 0; i < count; i++) {
+			hashMap[keys[i]] = i;
+			flatMap[keys[i]] = i;
+		}
+
+		int hashSum = 0, flatSum = 0;
+		uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			for (int i = 0; i < count; i++)
+				hashSum += hashMap.getValOrDefault(keys[i], 0);
+		}
+		uint32 hashTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			for (int i = 0; i < count; i++)
+				flatSum += flatMap.getValOrDefault(keys[i], 0);
+		}
+		uint32 flatTime = g_system->getMillis() - start;
+
+		debug("%d lookups: HashMap %d ms, FlatHashMap %d ms", iters * count, hashTime, flatTime);
+		TS_ASSERT_EQUALS(hashSum, flatSum);
+#endif
+	}
+};
@@ -1,6 +1,10 @@
 #include <cxxtest/TestSuite.h>
+#include "common/debug.h"
+#include "common/random.h"
+#include "common/system.h"
 #include "common/util.h"
 #include "common/formats/quicktime.h"
+#include "../../null_osystem.h"
 
 static const byte VALID_MOOV_DATA[] = { // a minimally 'correct' quicktime file.
 	// size				'moov'					size				'mdat'
@@ -32,6 +36,8 @@ public:
 	const Common::Rational &getScaleFactorY() const { return _scaleFactorY; }
 	const Common::Array<Track *> &getTracks() const { return _tracks; }
 
+	typedef SampleToChunkEntry ChunkEntry;
+
 	SampleDesc *readSampleDesc(Track *track, uint32 format, uint32 descSize) override {
 		return nullptr;
 	}
@@ -80,4 +86,130 @@ public:
 		TS_ASSERT(!result);
 	}
 
+	// A track with chunks of 1, 2, 2 and then 3 samples of growing sizes, and a key frame every 10 samples
+	static Common::QuickTimeParser::Track *createSampleTrack(uint32 sampleCount) {
+		Common::QuickTimeParser::Track *track = new Common::QuickTimeParser::Track();
+
+		track->frameCount = track->sampleCount = sampleCount;
+		track->sampleSizes = new uint32[sampleCount];
+		for (uint32 i = 0; i < sampleCount; i++)
+			track->sampleSizes[i] = i + 1;
+
+		track->sampleToChunkCount = 3;
+		QuickTimeTestParser::ChunkEntry *chunkEntries = new QuickTimeTestParser::ChunkEntry[3];
+		chunkEntries[0].first = 0;
+		chunkEntries[0].count = 1;
+		chunkEntries[0].id = 1;
+		chunkEntries[1].first = 1;
+		chunkEntries[1].count = 2;
+		chunkEntries[1].id = 2;
+		chunkEntries[2].first = 3;
+		chunkEntries[2].count = 3;
+		chunkEntries[2].id = 1;
+		track->sampleToChunk = chunkEntries;
+
+		track->chunkCount = 3 + (sampleCount - 5 + 2) / 3;
+		track->chunkOffsets = new uint32[track->chunkCount];
+		for (uint32 i = 0; i < track->chunkCount; i++)
+			track->chunkOffsets[i] = 1000 * i;
+
+		track->keyframeCount = (sampleCount + 9) / 10;
+		track->keyframes = new uint32[track->keyframeCount];
+		for (uint32 i = 0; i < track->keyframeCount; i++)
+			track->keyframes[i] = i * 10;
+
+		return track;
+	}
+
+	// Locate a sample by walking the chunk tables
+	static uint32 findSampleOffset(const Common::QuickTimeParser::Track *track, uint32 sample) {
+		uint32 totalSampleCount = 0;
+		uint32 sampleToChunkIndex = 0;
+
+		for (uint32 i = 0; i < track->chunkCount; i++) {
+			if (sampleToChunkIndex < track->sampleToChunkCount && i >= track->sampleToChunk[sampleToChunkIndex].first)
+				sampleToChunkIndex++;
+
+			totalSampleCount += track->sampleToChunk[sampleToChunkIndex - 1].count;
+
+			if (totalSampleCount > sample) {
+				uint32 offset = track->chunkOffsets[i];
+				for (uint32 j = totalSampleCount - track->sampleToChunk[sampleToChunkIndex - 1].count; j < sample; j++)
+					offset += track->sampleSizes[j];
+				return offset;
+			}
+		}
+
+		return 0;
+	}
+
+	void test_sampleIndex() {
+		Common::QuickTimeParser::Track *track = createSampleTrack(20);
+		track->buildSampleIndex();
+
+		TS_ASSERT_EQUALS(track->sampleIndex.size(), 20U);
+		TS_ASSERT_EQUALS(track->sampleIndex[0].offset, 0U);
+		TS_ASSERT_EQUALS(track->sampleIndex[1].offset, 1000U);
+		TS_ASSERT_EQUALS(track->sampleIndex[2].offset, 1002U);
+		TS_ASSERT_EQUALS(track->sampleIndex[2].descId, 2U);
+		TS_ASSERT_EQUALS(track->sampleIndex[4].offset, 2004U);
+		TS_ASSERT_EQUALS(track->sampleIndex[5].offset, 3000U);
+		TS_ASSERT_EQUALS(track->sampleIndex[5].descId, 1U);
+		TS_ASSERT_EQUALS(track->sampleIndex[7].offset, 3000U + 6 + 7);
+
+		for (uint32 i = 0; i < 20; i++)
+			TS_ASSERT_EQUALS(track->sampleIndex[i].offset, findSampleOffset(track, i));
+
+		delete track;
+	}
+
+	void test_findKeyFrame() {
+		Common::QuickTimeParser::Track *track = createSampleTrack(25);
+
+		TS_ASSERT_EQUALS(track->findKeyFrame(0), 0U);
+		TS_ASSERT_EQUALS(track->findKeyFrame(9), 0U);
+		TS_ASSERT_EQUALS(track->findKeyFrame(10), 10U);
+		TS_ASSERT_EQUALS(track->findKeyFrame(24), 20U);
+
+		// Without a sync sample table, every frame is a key frame
+		track->keyframeCount = 0;
+		TS_ASSERT_EQUALS(track->findKeyFrame(17), 17U);
+
+		delete track;
+	}
+
+	void test_seekSpeed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Compare random seeks through the index with walking the tables
+#ifdef SLOW_TESTS
+		const int seeks = 20000;
+#else
+		const int seeks = 200;
+#endif
+		const uint32 sampleCount = 30000;
+		Common::QuickTimeParser::Track *track = createSampleTrack(sampleCount);
+		Common::RandomSource rnd("quicktime");
+
+		uint32 walkSum = 0, indexSum = 0;
+		rnd.setSeed(1234);
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < seeks; i++)
+			walkSum += findSampleOffset(track, rnd.getRandomNumber(sampleCount - 1));
+		uint32 walkTime = g_system->getMillis() - start;
+
+		rnd.setSeed(1234);
+		start = g_system->getMillis();
+		track->buildSampleIndex();
+		for (int i = 0; i < seeks; i++)
+			indexSum += track->sampleIndex[rnd.getRandomNumber(sampleCount - 1)].offset;
+		uint32 indexTime = g_system->getMillis() - start;
+
+		debug("%d random seeks: table walk %d ms, sample index %d ms", seeks, walkTime, indexTime);
+		TS_ASSERT_EQUALS(walkSum, indexSum);
+
+		delete track;
+#endif
+	}
 };
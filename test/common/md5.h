@@ -1,7 +1,9 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/md5.h"
-#include "common/stream.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/substream.h"
 
 /*
  * those are the standard RFC 1321 test vectors
@@ -47,4 +49,31 @@ class MD5TestSuite : public CxxTest::TestSuite {
 		}
 	}
 
+	void test_computeStreamMD5s() {
+		const byte *data = (const byte *)md5_test_string[6];
+		uint32 size = strlen(md5_test_string[6]);
+		const uint32 lengths[] = { 0, 26, 1, 64, 100 };
+		Common::String md5s[ARRAYSIZE(lengths)];
+
+		// Hashed in place
+		Common::MemoryReadStream stream(data, size);
+		TS_ASSERT(Common::computeStreamMD5sAsString(stream, lengths, ARRAYSIZE(lengths), md5s));
+		for (uint i = 0; i < ARRAYSIZE(lengths); i++) {
+			Common::MemoryReadStream single(data, size);
+			TS_ASSERT_EQUALS(md5s[i], Common::computeStreamMD5AsString(single, lengths[i]));
+		}
+		TS_ASSERT_EQUALS(md5s[0], md5_test_digest[6]);
+		TS_ASSERT_EQUALS(md5s[4], md5_test_digest[6]);
+
+		// Hashed through reads
+		Common::MemoryReadStream parent(data, size);
+		Common::SubReadStream sub(&parent, size);
+		TS_ASSERT(Common::computeStreamMD5sAsString(sub, lengths, ARRAYSIZE(lengths), md5s));
+		for (uint i = 0; i < ARRAYSIZE(lengths); i++) {
+			Common::MemoryReadStream single(data, size);
+			TS_ASSERT_EQUALS(md5s[i], Common::computeStreamMD5AsString(single, lengths[i]));
+		}
+		TS_ASSERT_EQUALS(md5s[0], md5_test_digest[6]);
+	}
+
 };
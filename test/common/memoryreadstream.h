@@ -104,4 +104,19 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_contiguous_data() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		ms.seek(3);
+		TS_ASSERT_EQUALS(ms.getContiguousData(0, 7), contents);
+		TS_ASSERT_EQUALS(ms.getContiguousData(2, 5), contents + 2);
+		TS_ASSERT_EQUALS(ms.getContiguousData(7, 0), contents + 7);
+		TS_ASSERT(!ms.getContiguousData(2, 6));
+		TS_ASSERT(!ms.getContiguousData(-1, 1));
+
+		// The position is left alone
+		TS_ASSERT_EQUALS(ms.pos(), 3);
+	}
 };
@@ -0,0 +1,150 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/bufferedstream.h"
+
+// Counts the accesses to the wrapped stream
+class CountingReadStream : public Common::MemoryReadStream {
+public:
+	CountingReadStream(const byte *dataPtr, uint32 dataSize) : Common::MemoryReadStream(dataPtr, dataSize), _reads(0), _seeks(0) {}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		_reads++;
+		return Common::MemoryReadStream::read(dataPtr, dataSize);
+	}
+
+	bool seek(int64 offs, int whence = SEEK_SET) override {
+		_seeks++;
+		return Common::MemoryReadStream::seek(offs, whence);
+	}
+
+	int _reads;
+	int _seeks;
+};
+
+class PrefetchingReadStreamTestSuite : public CxxTest::TestSuite {
+	byte _contents[1000];
+
+	public:
+	void setUp() {
+		for (int i = 0; i < 1000; ++i)
+			_contents[i] = i * 7;
+	}
+
+	void test_traverse() {
+		CountingReadStream ms(_contents, 1000);
+
+		Common::SeekableReadStream &prs
+			= *Common::wrapPrefetchingReadStream(&ms, 64, DisposeAfterUse::NO);
+
+		for (int i = 0; i < 1000; ++i) {
+			TS_ASSERT(!prs.eos());
+			TS_ASSERT_EQUALS(i, prs.pos());
+			TS_ASSERT_EQUALS(prs.readByte(), (byte)(i * 7));
+		}
+
+		// Each read from the parent stream but the first refilled 3/4 of the window
+		TS_ASSERT(ms._reads <= 1 + 1000 / 48 + 1);
+		TS_ASSERT_EQUALS(ms._seeks, 0);
+
+		TS_ASSERT(!prs.eos());
+		TS_ASSERT_EQUALS(prs.readByte(), 0);
+		TS_ASSERT(prs.eos());
+
+		delete &prs;
+	}
+
+	void test_seek() {
+		CountingReadStream ms(_contents, 1000);
+
+		Common::SeekableReadStream &prs
+			= *Common::wrapPrefetchingReadStream(&ms, 64, DisposeAfterUse::NO);
+
+		prs.seek(100);
+		TS_ASSERT_EQUALS(prs.readByte(), (byte)(100 * 7));
+		TS_ASSERT_EQUALS(ms._reads, 1);
+
+		// Seeks within the window don't touch the parent stream
+		prs.seek(40, SEEK_CUR);
+		TS_ASSERT_EQUALS(prs.pos(), 141);
+		TS_ASSERT_EQUALS(prs.readByte(), (byte)(141 * 7));
+		prs.seek(-10, SEEK_CUR);
+		TS_ASSERT_EQUALS(prs.readByte(), (byte)(132 * 7));
+		TS_ASSERT_EQUALS(ms._reads, 1);
+		TS_ASSERT_EQUALS(ms._seeks, 1);
+
+		// Reading on at the end of the window keeps some data behind the position
+		prs.seek(164);
+		TS_ASSERT_EQUALS(prs.readByte(), (byte)(164 * 7));
+		prs.seek(150);
+		TS_ASSERT_EQUALS(prs.readByte(), (byte)(150 * 7));
+		TS_ASSERT_EQUALS(ms._reads, 2);
+
+		prs.seek(-1, SEEK_END);
+		TS_ASSERT_EQUALS(prs.readByte(), (byte)(999 * 7));
+		TS_ASSERT(!prs.eos());
+		prs.readByte();
+		TS_ASSERT(prs.eos());
+
+		TS_ASSERT(!prs.seek(1001));
+		TS_ASSERT(prs.seek(0));
+		TS_ASSERT(!prs.eos());
+		TS_ASSERT_EQUALS(prs.readByte(), 0);
+
+		delete &prs;
+	}
+
+	void test_large_read() {
+		CountingReadStream ms(_contents, 1000);
+
+		Common::SeekableReadStream &prs
+			= *Common::wrapPrefetchingReadStream(&ms, 64, DisposeAfterUse::NO);
+
+		byte buf[300];
+		prs.seek(10);
+		TS_ASSERT_EQUALS(prs.read(buf, 300), 300U);
+		for (int i = 0; i < 300; ++i)
+			TS_ASSERT_EQUALS(buf[i], (byte)((i + 10) * 7));
+		TS_ASSERT_EQUALS(prs.pos(), 310);
+
+		// Reads larger than the window go directly to the parent stream
+		TS_ASSERT_EQUALS(ms._reads, 1);
+
+		prs.seek(900);
+		TS_ASSERT_EQUALS(prs.read(buf, 300), 100U);
+		TS_ASSERT(prs.eos());
+		TS_ASSERT_EQUALS(buf[99], (byte)(999 * 7));
+
+		delete &prs;
+	}
+
+	void test_contiguous_data() {
+		Common::MemoryReadStream ms(_contents, 1000);
+
+		Common::SeekableReadStream &prs
+			= *Common::wrapPrefetchingReadStream(&ms, 64, DisposeAfterUse::NO);
+
+		// The data comes from the parent stream, not from the window, which
+		// is overwritten as reading goes on
+		prs.seek(500);
+		prs.readByte();
+		const byte *data = prs.getContiguousData(500, 200);
+		TS_ASSERT_EQUALS(data, _contents + 500);
+		TS_ASSERT(prs.getContiguousData(900, 101) == nullptr);
+
+		byte buf[128];
+		prs.seek(800);
+		prs.read(buf, sizeof(buf));
+		TS_ASSERT_EQUALS(prs.getContiguousData(500, 200), data);
+		TS_ASSERT_EQUALS(data[63], (byte)(563 * 7));
+
+		delete &prs;
+
+		// Without a memory backed parent there is nothing to hand out
+		Common::SeekableReadStream &unbacked
+			= *Common::wrapPrefetchingReadStream(Common::wrapBufferedSeekableReadStream(&ms, 64, DisposeAfterUse::NO), 64, DisposeAfterUse::YES);
+		unbacked.readByte();
+		TS_ASSERT(unbacked.getContiguousData(0, 1) == nullptr);
+		delete &unbacked;
+	}
+};
@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+// An archive with a fixed set of empty files, which counts how often it is asked for them
+class CountingArchive : public Common::Archive {
+public:
+	CountingArchive(const char *file) : _file(file), _queries(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		_queries++;
+		return path.equalsIgnoreCase(_file);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_file, *this)));
+		return 1;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		if (!path.equalsIgnoreCase(_file))
+			return Common::ArchiveMemberPtr();
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_file, *this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		_queries++;
+		if (!path.equalsIgnoreCase(_file))
+			return nullptr;
+		return new Common::MemoryReadStream(nullptr, 0);
+	}
+
+	Common::Path _file;
+	mutable int _queries;
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_lookup() {
+		Common::SearchSet set;
+		CountingArchive *arc1 = new CountingArchive("one.dat");
+		CountingArchive *arc2 = new CountingArchive("two.dat");
+		set.add("one", arc1, 1);
+		set.add("two", arc2);
+
+		TS_ASSERT(set.hasFile("one.dat"));
+		TS_ASSERT(set.hasFile("TWO.DAT"));
+		TS_ASSERT(!set.hasFile("three.dat"));
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("two.dat");
+		TS_ASSERT(stream != nullptr);
+		delete stream;
+
+		Common::Archive *container = nullptr;
+		TS_ASSERT(set.getMember("two.dat", &container));
+		TS_ASSERT_EQUALS(container, (Common::Archive *)arc2);
+	}
+
+	void test_cached_misses() {
+		Common::SearchSet set;
+		CountingArchive *arc1 = new CountingArchive("one.dat");
+		CountingArchive *arc2 = new CountingArchive("two.dat");
+		set.add("one", arc1);
+		set.add("two", arc2);
+
+		TS_ASSERT(!set.hasFile("three.dat"));
+		const int queries = arc1->_queries + arc2->_queries;
+
+		// Further lookups of the missing file don't reach the archives
+		TS_ASSERT(!set.hasFile("three.dat"));
+		TS_ASSERT(set.createReadStreamForMember("three.dat") == nullptr);
+		TS_ASSERT(!set.getMember("three.dat"));
+		TS_ASSERT_EQUALS(arc1->_queries + arc2->_queries, queries);
+
+		Common::SearchSet::LookupStats stats = set.getLookupStats();
+		TS_ASSERT_EQUALS(stats.lookups, 4U);
+		TS_ASSERT_EQUALS(stats.misses, 4U);
+		TS_ASSERT_EQUALS(stats.cachedMisses, 3U);
+
+		// Adding an archive forgets the misses
+		set.add("three", new CountingArchive("three.dat"));
+		TS_ASSERT(set.hasFile("three.dat"));
+
+		set.remove("three");
+		TS_ASSERT(!set.hasFile("three.dat"));
+		arc1->_file = "three.dat";
+		TS_ASSERT(!set.hasFile("three.dat"));
+		set.invalidateLookupCache();
+		TS_ASSERT(set.hasFile("three.dat"));
+	}
+
+	void test_missing_stream() {
+		Common::SearchSet set;
+		CountingArchive *arc = new CountingArchive("one.dat");
+		set.add("one", arc);
+
+		TS_ASSERT(set.createReadStreamForMember("two.dat") == nullptr);
+		const int queries = arc->_queries;
+		TS_ASSERT(set.createReadStreamForMember("two.dat") == nullptr);
+		TS_ASSERT_EQUALS(arc->_queries, queries);
+	}
+};
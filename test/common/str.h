@@ -1,9 +1,13 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/array.h"
+#include "common/debug.h"
 #include "common/str.h"
+#include "common/system.h"
 #include "common/ustr.h"
 
 #include "test/common/str-helper.h"
+#include "../null_osystem.h"
 
 class StringTestSuite : public CxxTest::TestSuite
 {
@@ -178,6 +182,50 @@ class StringTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(foo2, "hhhhh");
 	}
 
+	void test_refCount7() {
+		// using external storage with wide characters
+		Common::U32String foo1("fooasdkadklasdjklasdjlkasjdlkasjdklasjdlkjasdasd");
+		Common::U32String foo2(foo1);
+		Common::U32String foo3(foo2);
+		foo3 += Common::U32String("X");
+
+		TS_ASSERT_EQUALS(foo1, Common::U32String("fooasdkadklasdjklasdjlkasjdlkasjdklasjdlkjasdasd"));
+		TS_ASSERT_EQUALS(foo2, Common::U32String("fooasdkadklasdjklasdjlkasjdlkasjdklasjdlkjasdasd"));
+		TS_ASSERT_EQUALS(foo3, Common::U32String("fooasdkadklasdjklasdjlkasjdlkasjdklasjdlkjasdasdX"));
+		TS_ASSERT_EQUALS(foo1.c_str(), foo2.c_str());
+	}
+
+	void test_copy_speed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Copies of strings in external storage only touch the ref count
+#ifdef SLOW_TESTS
+		const int iters = 2000;
+#else
+		const int iters = 2;
+#endif
+		Common::Array<Common::String> originals;
+		for (int i = 0; i < 100; i++)
+			originals.push_back(Common::String::format("Some string long enough for the heap %d", i));
+
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < iters; i++) {
+			Common::Array<Common::String> copies(originals);
+			for (uint j = 0; j < copies.size(); j++) {
+				Common::String copy(copies[j]);
+				copies[j] = copy;
+			}
+		}
+		debug("Copying %d strings %d times took %d ms", (int)originals.size(), iters, g_system->getMillis() - start);
+
+		Common::String last(originals.back());
+		last += 'X';
+		TS_ASSERT_EQUALS(originals.back(), "Some string long enough for the heap 99");
+		TS_ASSERT_EQUALS(last, "Some string long enough for the heap 99X");
+#endif
+	}
+
 	void test_self_asignment() {
 		Common::String foo1("12345678901234567890123456789012");
 		foo1 = foo1.c_str() + 2;
@@ -0,0 +1,191 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+#include "common/scummsys.h"
+
+#ifdef USE_INDEO45
+#include "image/codecs/indeo/indeo_dsp.h"
+#endif
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite {
+#if defined(USE_INDEO45) && defined(SCUMMVM_SSE2)
+	// Wider than the blocks, to check the values next to them are untouched
+	static const int kPitch = 12;
+	static const int kIterations = 200;
+
+	typedef Image::Indeo::IndeoDSP DSP;
+	typedef void (*TransformFunc)(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	typedef void (*MCFunc)(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	typedef void (*MCAvgFunc)(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+
+	static int16 randomInt16(Common::RandomSource &rnd) {
+		return (int16)(rnd.getRandomNumber(0xFFFF) - 0x8000);
+	}
+
+	// Mostly small coefficients, as decoded from a stream, with a few out of range ones
+	static void randomCoeffs(Common::RandomSource &rnd, int32 *coeffs, int count) {
+		for (int i = 0; i < count; i++) {
+			switch (rnd.getRandomNumber(7)) {
+			case 0:
+				coeffs[i] = 0;
+				break;
+			case 1:
+				coeffs[i] = (int)rnd.getRandomNumber(0x3FFFF) - 0x20000;
+				break;
+			default:
+				coeffs[i] = (int)rnd.getRandomNumber(1023) - 512;
+				break;
+			}
+		}
+	}
+
+	static void checkTransform(Common::RandomSource &rnd, TransformFunc scalar, TransformFunc sse2, int blkSize) {
+		int32 coeffs[64];
+		uint8 flags[8];
+		int16 expected[8 * kPitch], actual[8 * kPitch];
+
+		for (int n = 0; n < kIterations; n++) {
+			randomCoeffs(rnd, coeffs, blkSize * blkSize);
+
+			// Empty columns, with flags which may not match them
+			for (int x = 0; x < blkSize; x++) {
+				if (rnd.getRandomNumber(2) == 0) {
+					for (int y = 1; y < blkSize; y++)
+						coeffs[y * blkSize + x] = 0;
+				}
+				flags[x] = rnd.getRandomNumber(1);
+			}
+
+			for (int i = 0; i < 8 * kPitch; i++)
+				expected[i] = actual[i] = randomInt16(rnd);
+
+			scalar(coeffs, expected, kPitch, flags);
+			sse2(coeffs, actual, kPitch, flags);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+		}
+	}
+
+	static void checkMC(Common::RandomSource &rnd, MCFunc scalar, MCFunc sse2) {
+		int16 ref[(8 + 1) * kPitch];
+		int16 expected[8 * kPitch], actual[8 * kPitch];
+
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < (8 + 1) * kPitch; i++)
+				ref[i] = randomInt16(rnd);
+
+			for (int mcType = 0; mcType < 4; mcType++) {
+				for (int i = 0; i < 8 * kPitch; i++)
+					expected[i] = actual[i] = randomInt16(rnd);
+
+				scalar(expected, ref, kPitch, mcType);
+				sse2(actual, ref, kPitch, mcType);
+				TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+			}
+		}
+	}
+
+	static void checkMCAvg(Common::RandomSource &rnd, MCAvgFunc scalar, MCAvgFunc sse2) {
+		int16 ref[(8 + 1) * kPitch], ref2[(8 + 1) * kPitch];
+		int16 expected[8 * kPitch], actual[8 * kPitch];
+
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < (8 + 1) * kPitch; i++) {
+				ref[i] = randomInt16(rnd);
+				ref2[i] = randomInt16(rnd);
+			}
+
+			for (int mcType = 0; mcType < 4; mcType++) {
+				for (int mcType2 = 0; mcType2 < 4; mcType2++) {
+					for (int i = 0; i < 8 * kPitch; i++)
+						expected[i] = actual[i] = randomInt16(rnd);
+
+					scalar(expected, ref, ref2, kPitch, mcType, mcType2);
+					sse2(actual, ref, ref2, kPitch, mcType, mcType2);
+					TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+				}
+			}
+		}
+	}
+#endif
+
+	public:
+	void test_transforms() {
+#if defined(USE_INDEO45) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() < 2)
+			return;
+
+		Common::RandomSource rnd("indeodsp");
+		checkTransform(rnd, DSP::ffIviInverseSlant8x8, DSP::ffIviInverseSlant8x8SSE2, 8);
+		checkTransform(rnd, DSP::ffIviInverseSlant4x4, DSP::ffIviInverseSlant4x4SSE2, 4);
+		checkTransform(rnd, DSP::ffIviRowSlant8, DSP::ffIviRowSlant8SSE2, 8);
+		checkTransform(rnd, DSP::ffIviColSlant8, DSP::ffIviColSlant8SSE2, 8);
+
+		TS_ASSERT_EQUALS(DSP::getSSE2Transform(DSP::ffIviInverseSlant8x8), DSP::ffIviInverseSlant8x8SSE2);
+		TS_ASSERT_EQUALS(DSP::getSSE2Transform(DSP::ffIviInverseSlant8x8SSE2), DSP::ffIviInverseSlant8x8SSE2);
+		TS_ASSERT_EQUALS(DSP::getSSE2Transform(DSP::ffIviPutPixels8x8), DSP::ffIviPutPixels8x8);
+#endif
+	}
+
+	void test_motion_compensation() {
+#if defined(USE_INDEO45) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() < 2)
+			return;
+
+		Common::RandomSource rnd("indeodsp");
+		checkMC(rnd, DSP::ffIviMc8x8Delta, DSP::ffIviMc8x8DeltaSSE2);
+		checkMC(rnd, DSP::ffIviMc4x4Delta, DSP::ffIviMc4x4DeltaSSE2);
+		checkMC(rnd, DSP::ffIviMc8x8NoDelta, DSP::ffIviMc8x8NoDeltaSSE2);
+		checkMC(rnd, DSP::ffIviMc4x4NoDelta, DSP::ffIviMc4x4NoDeltaSSE2);
+		checkMCAvg(rnd, DSP::ffIviMcAvg8x8Delta, DSP::ffIviMcAvg8x8DeltaSSE2);
+		checkMCAvg(rnd, DSP::ffIviMcAvg4x4Delta, DSP::ffIviMcAvg4x4DeltaSSE2);
+		checkMCAvg(rnd, DSP::ffIviMcAvg8x8NoDelta, DSP::ffIviMcAvg8x8NoDeltaSSE2);
+		checkMCAvg(rnd, DSP::ffIviMcAvg4x4NoDelta, DSP::ffIviMcAvg4x4NoDeltaSSE2);
+#endif
+	}
+
+	void test_output_rows() {
+#if defined(USE_INDEO45) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() < 2)
+			return;
+
+		Common::RandomSource rnd("indeodsp");
+		const int width = 60;
+		int16 src[width], b0[width / 2], b1[width / 2], b2[width / 2], b3[width / 2];
+		byte expected[2 * width], actual[2 * width];
+
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < width; i++)
+				src[i] = (n & 1) ? randomInt16(rnd) : (int16)((int)rnd.getRandomNumber(511) - 256);
+			for (int i = 0; i < width / 2; i++) {
+				b0[i] = randomInt16(rnd);
+				b1[i] = randomInt16(rnd);
+				b2[i] = randomInt16(rnd);
+				b3[i] = randomInt16(rnd);
+			}
+
+			for (int x = 0; x < width; x++)
+				expected[x] = Image::Indeo::avClipUint8(src[x] + 128);
+
+			// The decoder converts the rest of each row with the scalar code
+			int x = DSP::outputRowSSE2(src, actual, width);
+			TS_ASSERT(x > 0);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, x), 0);
+
+			for (x = 0; x < width; x += 2) {
+				const int i = x >> 1;
+				expected[x] = Image::Indeo::avClipUint8(((b0[i] + b1[i] + b2[i] + b3[i] + 2) >> 2) + 128);
+				expected[x + 1] = Image::Indeo::avClipUint8(((b0[i] + b1[i] - b2[i] - b3[i] + 2) >> 2) + 128);
+				expected[width + x] = Image::Indeo::avClipUint8(((b0[i] - b1[i] + b2[i] - b3[i] + 2) >> 2) + 128);
+				expected[width + x + 1] = Image::Indeo::avClipUint8(((b0[i] - b1[i] - b2[i] + b3[i] + 2) >> 2) + 128);
+			}
+
+			x = DSP::recomposeHaarRowSSE2(b0, b1, b2, b3, actual, width, width);
+			TS_ASSERT(x > 0);
+			TS_ASSERT_EQUALS(x & 1, 0);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, x), 0);
+			TS_ASSERT_EQUALS(memcmp(expected + width, actual + width, x), 0);
+		}
+#endif
+	}
+};
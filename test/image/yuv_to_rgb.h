@@ -0,0 +1,163 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/debug.h"
+#include "common/random.h"
+#include "common/system.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "../null_osystem.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	// Odd sizes, so that every SIMD row conversion leaves a few pixels to the tables
+	static const int kWidth = 70;
+	static const int kHeight = 18;
+	static const int kYPitch = 80;
+	static const int kUVPitch = 80;
+
+	byte _y[kYPitch * kHeight], _u[kUVPitch * kHeight], _v[kUVPitch * kHeight];
+
+	typedef void (Graphics::YUVToRGBManager::*ConvertFunc)(Graphics::Surface *, Graphics::YUVToRGBManager::LuminanceScale, const byte *, const byte *, const byte *, int, int, int, int);
+
+	void convert(Graphics::Surface &dst, ConvertFunc func, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		memset(dst.getPixels(), 0, dst.h * dst.pitch);
+		(YUVToRGBMan.*func)(&dst, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+	}
+
+	void checkRowFuncs(Graphics::YUVToRGBRowFunc<uint16> rowFunc16, Graphics::YUVToRGBRowFunc<uint32> rowFunc32) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 0, 4, 8, 12),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+		const ConvertFunc funcs[] = {
+			&Graphics::YUVToRGBManager::convert444,
+			&Graphics::YUVToRGBManager::convert422,
+			&Graphics::YUVToRGBManager::convert420
+		};
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+
+		Graphics::YUVToRGBManager &man = YUVToRGBMan;
+		man._rowFuncsSelected = true;
+
+		for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+			Graphics::Surface expected, actual;
+			expected.create(kWidth, kHeight, formats[f]);
+			actual.create(kWidth, kHeight, formats[f]);
+
+			for (uint c = 0; c < ARRAYSIZE(funcs); c++) {
+				for (uint s = 0; s < ARRAYSIZE(scales); s++) {
+					man._rowFunc16 = nullptr;
+					man._rowFunc32 = nullptr;
+					convert(expected, funcs[c], scales[s]);
+
+					man._rowFunc16 = rowFunc16;
+					man._rowFunc32 = rowFunc32;
+					convert(actual, funcs[c], scales[s]);
+
+					TS_ASSERT_EQUALS(memcmp(expected.getPixels(), actual.getPixels(), kHeight * expected.pitch), 0);
+				}
+			}
+
+			expected.free();
+			actual.free();
+		}
+
+		man._rowFunc16 = nullptr;
+		man._rowFunc32 = nullptr;
+	}
+
+	public:
+	void setUp() {
+		// Random planes, with the extremes which need clipping at the start
+		Common::RandomSource rnd("yuvtest");
+		for (int i = 0; i < kYPitch * kHeight; i++)
+			_y[i] = rnd.getRandomNumber(255);
+		for (int i = 0; i < kUVPitch * kHeight; i++) {
+			_u[i] = rnd.getRandomNumber(255);
+			_v[i] = rnd.getRandomNumber(255);
+		}
+
+		const byte extremes[] = { 0, 255, 16, 235, 0, 0, 255, 255 };
+		for (int i = 0; i < ARRAYSIZE(extremes); i++) {
+			_y[i] = extremes[i];
+			_u[i] = extremes[(i + 1) % ARRAYSIZE(extremes)];
+			_v[i] = extremes[(i + 2) % ARRAYSIZE(extremes)];
+		}
+	}
+
+	void test_simd_matches_tables() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkRowFuncs(Graphics::convertYUVRowSSE2<uint16>, Graphics::convertYUVRowSSE2<uint32>);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkRowFuncs(Graphics::convertYUVRowAVX2<uint16>, Graphics::convertYUVRowAVX2<uint32>);
+#endif
+#endif
+	}
+
+	void test_convert_speed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 500;
+#else
+		const int iters = 5;
+#endif
+		const int width = 640, height = 480;
+		byte *y = new byte[width * height];
+		byte *uv = new byte[width * height / 4];
+		for (int i = 0; i < width * height; i++)
+			y[i] = i * 7;
+		for (int i = 0; i < width * height / 4; i++)
+			uv[i] = i * 3;
+
+		Graphics::Surface dst;
+		dst.create(width, height, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+		Graphics::YUVToRGBManager &man = YUVToRGBMan;
+		man._rowFuncsSelected = true;
+		man._rowFunc32 = nullptr;
+
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < iters; i++)
+			man.convert420(&dst, Graphics::YUVToRGBManager::kScaleITU, y, uv, uv, width, height, width, width / 2);
+		uint32 tableTime = g_system->getMillis() - start;
+
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			man._rowFunc32 = Graphics::convertYUVRowSSE2<uint32>;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			man._rowFunc32 = Graphics::convertYUVRowAVX2<uint32>;
+#endif
+
+		start = g_system->getMillis();
+		for (int i = 0; i < iters; i++)
+			man.convert420(&dst, Graphics::YUVToRGBManager::kScaleITU, y, uv, uv, width, height, width, width / 2);
+		uint32 simdTime = g_system->getMillis() - start;
+
+		man._rowFunc32 = nullptr;
+		debug("%d 640x480 YUV420 frames: tables %d ms, SIMD %d ms", iters, tableTime, simdTime);
+
+		dst.free();
+		delete[] y;
+		delete[] uv;
+#endif
+	}
+};
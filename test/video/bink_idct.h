@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+#include "video/bink_decoder.h"
+#endif
+
+class BinkIDCTTestSuite : public CxxTest::TestSuite {
+#if defined(USE_BINK) && defined(SCUMMVM_SSE2)
+	typedef Video::BinkDecoder::BinkVideoTrack Track;
+
+	static const int kPitch = 12;
+	static const int kNumBlocks = 256;
+
+	int32 _blocks[kNumBlocks][64];
+
+	void checkBlock(const int32 *block, Common::RandomSource &rnd) {
+		int32 expected[64], actual[64];
+		memcpy(expected, block, sizeof(expected));
+		memcpy(actual, block, sizeof(actual));
+		Track::IDCTScalar(expected);
+		Track::IDCTSSE2(actual);
+		TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+
+		// Put and add into a wider buffer, to check the bytes next to the block are untouched
+		byte expectedPixels[8 * kPitch], actualPixels[8 * kPitch];
+		for (int i = 0; i < 8 * kPitch; i++)
+			expectedPixels[i] = actualPixels[i] = rnd.getRandomNumber(255);
+
+		Track::IDCTPutScalar(expectedPixels, kPitch, block);
+		Track::IDCTPutSSE2(actualPixels, kPitch, block);
+		TS_ASSERT_EQUALS(memcmp(expectedPixels, actualPixels, sizeof(expectedPixels)), 0);
+
+		memcpy(expected, block, sizeof(expected));
+		Track::IDCTAddScalar(expectedPixels, kPitch, expected);
+		Track::IDCTAddSSE2(actualPixels, kPitch, block);
+		TS_ASSERT_EQUALS(memcmp(expectedPixels, actualPixels, sizeof(expectedPixels)), 0);
+	}
+#endif
+
+	public:
+	void test_sse2_matches_scalar() {
+#if defined(USE_BINK) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() < 2)
+			return;
+
+		Common::RandomSource rnd("binkidct");
+		for (int b = 0; b < kNumBlocks; b++) {
+			int32 *block = _blocks[b];
+			for (int i = 0; i < 64; i++)
+				block[i] = (int)rnd.getRandomNumber(2046) - 1023;
+
+			switch (b % 8) {
+			case 0:
+				// Only the first row, so all columns take the shortcut of the scalar code
+				for (int i = 8; i < 64; i++)
+					block[i] = 0;
+				break;
+			case 1:
+				// Some columns with only a DC coefficient
+				for (int i = 8; i < 64; i++) {
+					if (i & 1)
+						block[i] = 0;
+				}
+				break;
+			case 2:
+				// Large coefficients, which give results far outside of the range of a byte
+				for (int i = 0; i < 64; i++)
+					block[i] = (block[i] < 0) ? -1023 : 1023;
+				break;
+			case 3:
+				// Sparse blocks, as most of the coded ones are
+				for (int i = 0; i < 64; i++) {
+					if (rnd.getRandomNumber(7))
+						block[i] = 0;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		// Blocks which saturate in every direction
+		for (int i = 0; i < 64; i++) {
+			_blocks[0][i] = 1023;
+			_blocks[8][i] = -1023;
+			_blocks[16][i] = (i & 1) ? -1023 : 1023;
+			_blocks[24][i] = ((i >> 3) & 1) ? 1023 : -1023;
+			_blocks[32][i] = 0;
+		}
+		_blocks[40][0] = 1 << 20;
+		for (int i = 1; i < 64; i++)
+			_blocks[40][i] = 0;
+
+		for (int b = 0; b < kNumBlocks; b++)
+			checkBlock(_blocks[b], rnd);
+#endif
+	}
+};
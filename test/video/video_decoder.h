@@ -0,0 +1,129 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str.h"
+#include "common/system.h"
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+#include "../null_osystem.h"
+
+class DecodeAheadTestDecoder : public Video::VideoDecoder {
+public:
+	bool loadStream(Common::SeekableReadStream *stream) override {
+		close();
+		addTrack(new TestTrack());
+		return true;
+	}
+
+private:
+	// A track whose frames are filled with their frame number. Every fourth
+	// frame changes the palette, so that with a queue of two or four slots
+	// the palette changes land in the same slot.
+	class TestTrack : public FixedRateVideoTrack {
+	public:
+		static const int kFrameCount = 30;
+
+		TestTrack() : _curFrame(-1), _dirtyPalette(false) {
+			_surface.create(4, 4, Graphics::PixelFormat::createFormatCLUT8());
+			memset(_palette, 0, sizeof(_palette));
+		}
+		~TestTrack() { _surface.free(); }
+
+		uint16 getWidth() const override { return _surface.w; }
+		uint16 getHeight() const override { return _surface.h; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return kFrameCount; }
+		bool isSeekable() const override { return true; }
+		bool seek(const Audio::Timestamp &time) override { _curFrame = getFrameAtTime(time) - 1; return true; }
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			memset(_surface.getPixels(), _curFrame, _surface.h * _surface.pitch);
+			if ((_curFrame % 4) == 0) {
+				memset(_palette, _curFrame, sizeof(_palette));
+				_dirtyPalette = true;
+			}
+			return &_surface;
+		}
+
+		bool hasDirtyPalette() const override { return _dirtyPalette; }
+		const byte *getPalette() const override { _dirtyPalette = false; return _palette; }
+
+	protected:
+		Common::Rational getFrameRate() const override { return 100; }
+
+	private:
+		Graphics::Surface _surface;
+		int _curFrame;
+		byte _palette[256 * 3];
+		mutable bool _dirtyPalette;
+	};
+};
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite {
+	// Describes the frames shown, with the palette in use for each of them
+	Common::String play(uint decodeAhead, const uint *seekFrames, uint seekCount) {
+		DecodeAheadTestDecoder decoder;
+		decoder.loadStream(nullptr);
+		TS_ASSERT(decoder.setDecodeAhead(decodeAhead));
+
+		Common::String frames;
+		for (uint shown = 0; !decoder.endOfVideo() && shown < 100; shown++) {
+			const Graphics::Surface *surface = decoder.decodeNextFrame();
+			if (!surface)
+				break;
+
+			const byte *palette = decoder.getPalette();
+			frames += Common::String::format("%d/%d/%d ", *(const byte *)surface->getPixels(), decoder.getCurFrame(), palette ? palette[767] : -1);
+
+			// Decode ahead as far as the queue allows, which overwrites its other slots
+			for (uint i = 0; i <= decodeAhead; i++)
+				decoder.decodeAhead();
+
+			if (shown < seekCount)
+				decoder.seekToFrame(seekFrames[shown]);
+		}
+
+		return frames;
+	}
+
+	public:
+	void test_decode_ahead_palette() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Common::String expected = play(0, nullptr, 0);
+		for (uint ahead = 1; ahead <= 4; ahead++)
+			TS_ASSERT_EQUALS(play(ahead, nullptr, 0), expected);
+#endif
+	}
+
+	void test_decode_ahead_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Seek after some of the frames, both forward and back, and to
+		// frames on either side of a palette change
+		const uint seekFrames[] = { 1, 1, 20, 21, 3, 8, 7, 7, 25, 0, 12, 11 };
+		const uint seekCount = ARRAYSIZE(seekFrames);
+
+		const Common::String expected = play(0, seekFrames, seekCount);
+		for (uint ahead = 1; ahead <= 4; ahead++)
+			TS_ASSERT_EQUALS(play(ahead, seekFrames, seekCount), expected);
+#endif
+	}
+
+	void test_decode_ahead_late() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		DecodeAheadTestDecoder decoder;
+		decoder.loadStream(nullptr);
+		decoder.decodeNextFrame();
+
+		// Once frames are decoded, the queue can't be set up anymore
+		TS_ASSERT(!decoder.setDecodeAhead(2));
+#endif
+	}
+};
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -703,49 +704,56 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	// Reset any palette, if necessary
 	videoTrack->useInitialPalette();
 
+	const IndexEntries::StreamEntries *videoEntries = _indexEntries.getStream(videoIndex);
+	if (!videoEntries)
+		return false;
+
+	// Positions in the video stream's entries of the last keyframe
+	// and the target frame
 	int lastKeyFrame = -1;
 	int frameIndex = -1;
-	uint curFrame = 0;
-
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
 
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
+	if (!videoEntries->hasPaletteChanges) {
+		// Each entry is a frame, so the frame can be looked up directly
+		if (frame >= videoEntries->entries.size())
+			return false;
 
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
+		frameIndex = frame;
+		const uint32 *keyFrame = Common::upperBound(videoEntries->keyFrames.begin(), videoEntries->keyFrames.end(), frame);
+		lastKeyFrame = *(keyFrame - 1);
+	} else {
+		// Go through and figure out where we should be
+		// If there's a palette, we need to find the palette too
+		uint curFrame = 0;
 
-		uint16 streamType = getStreamType(index.id);
+		for (uint32 i = 0; i < videoEntries->entries.size(); i++) {
+			const OldIndex &index = _indexEntries[videoEntries->entries[i]];
 
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
+			if (getStreamType(index.id) == kStreamTypePaletteChange) {
+				// We need to handle any palette change we see since there's no
+				// flag to tell if this is a "key" palette.
+				// Decode the palette
+				_fileStream->seek(index.offset + 8);
+				Common::SeekableReadStream *chunk = 0;
 
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+				if (index.size != 0)
+					chunk = _fileStream->readStream(index.size);
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
+				videoTrack->loadPaletteFromChunk(chunk);
+			} else {
+				// Check to see if this is a keyframe
+				// The first frame has to be a keyframe
+				if ((index.flags & AVIIF_INDEX) || curFrame == 0)
+					lastKeyFrame = i;
+
+				// Did we find the target frame?
+				if (frame == curFrame) {
+					frameIndex = i;
+					break;
+				}
 
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
+				curFrame++;
 			}
-
-			curFrame++;
 		}
 	}
 
@@ -762,25 +770,15 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
+		const IndexEntries::StreamEntries *audioEntries = _indexEntries.getStream(_audioTracks[i].index);
+		if (audioEntries && frame < audioEntries->entries.size()) {
+			const uint32 j = audioEntries->entries[frame];
 			const OldIndex &index = _indexEntries[j];
 
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
-
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
-
-				chunksFound++;
-			}
+			_fileStream->seek(index.offset + 8);
+			Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
+			audioTrack->queueSound(audioChunk);
+			_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
@@ -789,24 +787,18 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 
 	// Decode from keyFrame to curFrame - 1
 	for (int i = lastKeyFrame; i < frameIndex; i++) {
-		if (_indexEntries[i].id == ID_REC)
-			continue;
-
-		if (getStreamIndex(_indexEntries[i].id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(_indexEntries[i].id);
+		const OldIndex &index = _indexEntries[videoEntries->entries[i]];
 
 		// Ignore palettes, they were already handled
-		if (streamType == kStreamTypePaletteChange)
+		if (getStreamType(index.id) == kStreamTypePaletteChange)
 			continue;
 
 		// Frame, hopefully
-		_fileStream->seek(_indexEntries[i].offset + 8);
+		_fileStream->seek(index.offset + 8);
 		Common::SeekableReadStream *chunk = 0;
 
-		if (_indexEntries[i].size != 0)
-			chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
 		videoTrack->decodeFrame(chunk);
 	}
@@ -819,7 +811,7 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	videoTrack->setCurFrame(frame - 1);
 
 	// Set the video track's search offset to the right spot
-	_videoTracks[0].chunkSearchOffset = _indexEntries[frameIndex].offset;
+	_videoTracks[0].chunkSearchOffset = _indexEntries[videoEntries->entries[frameIndex]].offset;
 	return true;
 }
 
@@ -909,6 +901,8 @@ void AVIDecoder::readOldIndex(uint32 size) {
 		_indexEntries.push_back(indexEntry);
 		debugC(7, kDebugLevelGVideo, "Index %d: Tag '%s', Offset = %d, Size = %d (Flags = %d)", i, tag2str(indexEntry.id), indexEntry.offset, indexEntry.size, indexEntry.flags);
 	}
+
+	_indexEntries.buildStreamIndex();
 }
 
 void AVIDecoder::checkTruemotion1() {
@@ -1224,15 +1218,50 @@ AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
 }
 
 AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
-	for (uint idx = 0, frameCtr = 0; idx < size(); ++idx) {
-		if ((*this)[idx].id != ID_REC &&
-				AVIDecoder::getStreamIndex((*this)[idx].id) == index) {
-			if (frameCtr++ == frameNumber)
-				return &(*this)[idx];
+	const StreamEntries *stream = getStream(index);
+	if (!stream || frameNumber >= stream->entries.size())
+		return nullptr;
+
+	return &(*this)[stream->entries[frameNumber]];
+}
+
+const AVIDecoder::IndexEntries::StreamEntries *AVIDecoder::IndexEntries::getStream(uint index) const {
+	if (index >= _streams.size())
+		return nullptr;
+
+	return &_streams[index];
+}
+
+void AVIDecoder::IndexEntries::buildStreamIndex() {
+	_streams.clear();
+
+	for (uint idx = 0; idx < size(); ++idx) {
+		const OldIndex &entry = (*this)[idx];
+
+		// RECs don't belong to any stream
+		if (entry.id == ID_REC)
+			continue;
+
+		const uint index = AVIDecoder::getStreamIndex(entry.id);
+		if (index >= _streams.size())
+			_streams.resize(index + 1);
+
+		StreamEntries &stream = _streams[index];
+
+		if (AVIDecoder::getStreamType(entry.id) == kStreamTypePaletteChange) {
+			stream.hasPaletteChanges = true;
+		} else if ((entry.flags & AVIIF_INDEX) || stream.keyFrames.empty()) {
+			// The first frame has to be a keyframe
+			stream.keyFrames.push_back(stream.entries.size());
 		}
+
+		stream.entries.push_back(idx);
 	}
+}
 
-	return nullptr;
+void AVIDecoder::IndexEntries::clear() {
+	Common::Array<OldIndex>::clear();
+	_streams.clear();
 }
 
 } // End of namespace Video
@@ -320,7 +320,24 @@ protected:
 
 	class IndexEntries : public Common::Array<OldIndex> {
 	public:
+		/** The index entries belonging to one stream. */
+		struct StreamEntries {
+			Common::Array<uint32> entries;   ///< Positions of the stream's entries in the index
+			Common::Array<uint32> keyFrames; ///< Positions in entries of the key frames
+			bool hasPaletteChanges;
+
+			StreamEntries() : hasPaletteChanges(false) {}
+		};
+
 		OldIndex *find(uint index, uint frameNumber);
+		const StreamEntries *getStream(uint index) const;
+
+		/** Sort the entries by stream, after the index was read. */
+		void buildStreamIndex();
+		void clear();
+
+	private:
+		Common::Array<StreamEntries> _streams;
 	};
 
 	AVIHeader _header;
@@ -346,7 +363,7 @@ protected:
 	void handleStreamHeader(uint32 size);
 	void readStreamName(uint32 size);
 	void readPalette8(uint32 size);
-	uint16 getStreamType(uint32 tag) const { return tag & 0xFFFF; }
+	static uint16 getStreamType(uint32 tag) { return tag & 0xFFFF; }
 	static byte getStreamIndex(uint32 tag);
 	void checkTruemotion1();
 	uint getVideoTrackOffset(uint trackIndex, uint frameNumber = 0);
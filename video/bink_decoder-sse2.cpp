@@ -0,0 +1,189 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// SSE2 versions of the Bink IDCT. Each pass works on four rows or columns
+// at once with 32-bit lanes, so the results are the same as those of the
+// IDCT_TRANSFORM macro in bink_decoder.cpp, bit for bit.
+
+#include "common/scummsys.h"
+
+#include "video/bink_decoder.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Video {
+
+namespace {
+
+// The low 32 bits of the product, like a plain int multiplication
+template<int c>
+FORCEINLINE __m128i mulConst(__m128i a) {
+	const __m128i k = _mm_set1_epi32(c);
+	const __m128i even = _mm_mul_epu32(a, k);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), k);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+template<int c>
+FORCEINLINE __m128i mulShift(__m128i a) {
+	return _mm_srai_epi32(mulConst<c>(a), 11);
+}
+
+FORCEINLINE void transpose4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Transposes an 8x8 block, stored as two vectors per row
+FORCEINLINE void transpose8(__m128i v[8][2]) {
+	transpose4(v[0][0], v[1][0], v[2][0], v[3][0]);
+	transpose4(v[0][1], v[1][1], v[2][1], v[3][1]);
+	transpose4(v[4][0], v[5][0], v[6][0], v[7][0]);
+	transpose4(v[4][1], v[5][1], v[6][1], v[7][1]);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = v[i][1];
+		v[i][1] = v[i + 4][0];
+		v[i + 4][0] = t;
+	}
+}
+
+// One pass of the transform over the columns in half h of the block
+template<bool munge>
+FORCEINLINE void transform(__m128i v[8][2], int h) {
+	const __m128i s0 = v[0][h], s1 = v[1][h], s2 = v[2][h], s3 = v[3][h];
+	const __m128i s4 = v[4][h], s5 = v[5][h], s6 = v[6][h], s7 = v[7][h];
+
+	const __m128i a0 = _mm_add_epi32(s0, s4);
+	const __m128i a1 = _mm_sub_epi32(s0, s4);
+	const __m128i a2 = _mm_add_epi32(s2, s6);
+	const __m128i a3 = mulShift<2896>(_mm_sub_epi32(s2, s6));
+	const __m128i a4 = _mm_add_epi32(s5, s3);
+	const __m128i a5 = _mm_sub_epi32(s5, s3);
+	const __m128i a6 = _mm_add_epi32(s1, s7);
+	const __m128i a7 = _mm_sub_epi32(s1, s7);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = mulShift<3784>(_mm_add_epi32(a5, a7));
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(mulShift<-5352>(a5), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(mulShift<2896>(_mm_sub_epi32(a6, a4)), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(mulShift<2217>(a7), b3), b1);
+
+	const __m128i c0 = _mm_add_epi32(a0, a2);
+	const __m128i c1 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i c2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+	const __m128i c3 = _mm_sub_epi32(a0, a2);
+
+	v[0][h] = _mm_add_epi32(c0, b0);
+	v[1][h] = _mm_add_epi32(c1, b2);
+	v[2][h] = _mm_add_epi32(c2, b3);
+	v[3][h] = _mm_sub_epi32(c3, b4);
+	v[4][h] = _mm_add_epi32(c3, b4);
+	v[5][h] = _mm_sub_epi32(c2, b3);
+	v[6][h] = _mm_sub_epi32(c1, b2);
+	v[7][h] = _mm_sub_epi32(c0, b0);
+
+	if (munge) {
+		for (int i = 0; i < 8; i++)
+			v[i][h] = _mm_srai_epi32(_mm_add_epi32(v[i][h], _mm_set1_epi32(0x7F)), 8);
+	}
+}
+
+void idct(__m128i v[8][2], const int32 *block) {
+	for (int i = 0; i < 8; i++) {
+		v[i][0] = _mm_loadu_si128((const __m128i *)(block + i * 8));
+		v[i][1] = _mm_loadu_si128((const __m128i *)(block + i * 8 + 4));
+	}
+
+	// Columns first, then the rows, by transposing in between
+	transform<false>(v, 0);
+	transform<false>(v, 1);
+	transpose8(v);
+	transform<true>(v, 0);
+	transform<true>(v, 1);
+	transpose8(v);
+}
+
+// The low bytes of a row, as the scalar code stores them into a byte
+FORCEINLINE __m128i rowBytes(const __m128i row[2]) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i words = _mm_packs_epi32(_mm_and_si128(row[0], mask), _mm_and_si128(row[1], mask));
+	return _mm_packus_epi16(words, words);
+}
+
+} // End of anonymous namespace
+
+void BinkDecoder::BinkVideoTrack::IDCTSSE2(int32 *block) {
+	__m128i v[8][2];
+	idct(v, block);
+
+	for (int i = 0; i < 8; i++) {
+		_mm_storeu_si128((__m128i *)(block + i * 8), v[i][0]);
+		_mm_storeu_si128((__m128i *)(block + i * 8 + 4), v[i][1]);
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPutSSE2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i v[8][2];
+	idct(v, block);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		_mm_storel_epi64((__m128i *)dest, rowBytes(v[i]));
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTAddSSE2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i v[8][2];
+	idct(v, block);
+
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i pixels = _mm_loadl_epi64((const __m128i *)dest);
+		_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(pixels, rowBytes(v[i])));
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -243,9 +243,14 @@ BinkDecoder::AudioInfo::~AudioInfo() {
 }
 
 BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, bool swapPlanes, bool hasAlpha, uint32 id) :
-		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr) {
+		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr), _frameTarget(nullptr) {
 	_curFrame = -1;
 
+	_useSSE2 = false;
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
+
 	for (int i = 0; i < 16; i++)
 		_huffman[i] = 0;
 
@@ -481,13 +486,14 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
+	Graphics::Surface *dst = _frameTarget ? _frameTarget : _surface;
 	if (_hasAlpha) {
 		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
-		YUVToRGBMan.convert420Alpha(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
+		YUVToRGBMan.convert420Alpha(dst, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
 				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
 	} else {
 		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
+		YUVToRGBMan.convert420(dst, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
 				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
 	}
 
@@ -498,6 +504,15 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	_curFrame++;
 }
 
+bool BinkDecoder::BinkVideoTrack::canSetFrameTarget(const Graphics::PixelFormat &format) const {
+	// The planes of odd-sized videos are converted with an extra row or
+	// column, which would not fit into a target of the video size
+	if (_surfaceWidth != _width || _surfaceHeight != _height)
+		return false;
+
+	return format.bytesPerPixel == 2 || format.bytesPerPixel == 4;
+}
+
 void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
 	uint32 blockWidth  = isChroma ? _uvBlockWidth  : _yBlockWidth;
 	uint32 blockHeight = isChroma ? _uvBlockHeight : _yBlockHeight;
@@ -1462,6 +1477,39 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 }
 
 void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+#ifdef SCUMMVM_SSE2
+	if (_useSSE2) {
+		IDCTSSE2(block);
+		return;
+	}
+#endif
+
+	IDCTScalar(block);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+#ifdef SCUMMVM_SSE2
+	if (_useSSE2) {
+		IDCTAddSSE2(ctx.dest, ctx.pitch, block);
+		return;
+	}
+#endif
+
+	IDCTAddScalar(ctx.dest, ctx.pitch, block);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
+#ifdef SCUMMVM_SSE2
+	if (_useSSE2) {
+		IDCTPutSSE2(ctx.dest, ctx.pitch, block);
+		return;
+	}
+#endif
+
+	IDCTPutScalar(ctx.dest, ctx.pitch, block);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTScalar(int32 *block) {
 	int i;
 	int32 temp[64];
 
@@ -1472,23 +1520,22 @@ void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+void BinkDecoder::BinkVideoTrack::IDCTAddScalar(byte *dest, uint32 pitch, int32 *block) {
 	int i, j;
 
-	IDCT(block);
-	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+	IDCTScalar(block);
+	for (i = 0; i < 8; i++, dest += pitch, block += 8)
 		for (j = 0; j < 8; j++)
 			 dest[j] += block[j];
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
+void BinkDecoder::BinkVideoTrack::IDCTPutScalar(byte *dest, uint32 pitch, const int32 *block) {
 	int i;
 	int32 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
 	}
 }
 
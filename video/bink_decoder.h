@@ -58,6 +58,8 @@ namespace Graphics {
 struct Surface;
 }
 
+class BinkIDCTTestSuite;
+
 namespace Video {
 
 /**
@@ -84,6 +86,8 @@ protected:
 	uint32 findKeyFrame(uint32 frame) const;
 
 private:
+	friend class ::BinkIDCTTestSuite;
+
 	static const int kAudioChannelsMax  = 2;
 	static const int kAudioBlockSizeMax = (kAudioChannelsMax << 11);
 
@@ -163,6 +167,8 @@ private:
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
 		const Graphics::Surface *decodeNextFrame() override { return _surface; }
+		bool canSetFrameTarget(const Graphics::PixelFormat &format) const override;
+		void setFrameTarget(Graphics::Surface *target) override { _frameTarget = target; }
 		bool isSeekable() const  override{ return true; }
 		bool seek(const Audio::Timestamp &time) override { return true; }
 		bool rewind() override;
@@ -174,6 +180,8 @@ private:
 		Common::Rational getFrameRate() const override { return _frameRate; }
 
 	private:
+		friend class ::BinkIDCTTestSuite;
+
 		/** A decoder state. */
 		struct DecodeContext {
 			VideoFrame *video;
@@ -251,6 +259,7 @@ private:
 		int _frameCount;
 
 		Graphics::Surface *_surface;
+		Graphics::Surface *_frameTarget; ///< Surface to convert the frames into instead of _surface
 		Graphics::PixelFormat _pixelFormat;
 		uint16 _width;
 		uint16 _height;
@@ -261,6 +270,7 @@ private:
 
 		bool _hasAlpha;   ///< Do video frames have alpha?
 		bool _swapPlanes; ///< Are the planes ordered (A)YVU instead of (A)YUV?
+		bool _useSSE2;    ///< Use the SSE2 IDCT?
 
 		Common::Rational _frameRate;
 
@@ -341,6 +351,17 @@ private:
 		void IDCT(int32 *block);
 		void IDCTPut(DecodeContext &ctx, int32 *block);
 		void IDCTAdd(DecodeContext &ctx, int32 *block);
+
+		static void IDCTScalar(int32 *block);
+		static void IDCTPutScalar(byte *dest, uint32 pitch, const int32 *block);
+		static void IDCTAddScalar(byte *dest, uint32 pitch, int32 *block);
+
+#ifdef SCUMMVM_SSE2
+		// SSE2 versions of the IDCT, which give exactly the same results
+		static void IDCTSSE2(int32 *block);
+		static void IDCTPutSSE2(byte *dest, uint32 pitch, const int32 *block);
+		static void IDCTAddSSE2(byte *dest, uint32 pitch, const int32 *block);
+#endif
 	};
 
 	class BinkAudioTrack : public AudioTrack {
@@ -19,6 +19,10 @@ MODULE_OBJS := \
 ifdef USE_BINK
 MODULE_OBJS += \
 	bink_decoder.o
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_decoder-sse2.o
+endif
 endif
 
 ifdef USE_HNM
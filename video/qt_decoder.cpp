@@ -330,6 +330,9 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 		checkEditListBounds();
 	}
 
+	// Index the sample locations once, instead of walking the chunk tables for every frame
+	_parent->buildSampleIndex();
+
 	_curEdit = 0;
 	_curFrame = -1;
 	_delayedFrameToBufferTo = -1;
@@ -716,42 +719,17 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
-
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
-
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
-
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
-
-	if (actualChunk < 0)
+	// Look up where the sample for the frame is stored
+	if (_curFrame < 0 || (uint32)_curFrame >= _parent->sampleIndex.size())
 		error("Could not find data for frame %d", _curFrame);
 
-	// Next seek to that frame
+	const Common::QuickTimeParser::SampleLocation &location = _parent->sampleIndex[_curFrame];
+	descId = location.descId;
+
+	// Then seek to that frame and read in its raw data
 	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
-
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
-	}
+	stream->seek(location.offset);
 
-	// Finally, read in the raw data for the frame
 	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
 
 	if (_parent->sampleSize != 0)
@@ -776,12 +754,7 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
-
-	// If none found, we'll assume the requested frame is a key frame
-	return frame;
+	return _parent->findKeyFrame(frame);
 }
 
 bool QuickTimeDecoder::VideoTrackHandler::isEmptyEdit() const {
@@ -409,6 +409,7 @@ private:
 		Common::QuickTimeParser::Track *_parent;
 
 		void projectPanorama();
+		void updateWarpTables(uint16 w, uint16 h);
 
 		const Graphics::Surface *bufferNextFrame();
 
@@ -422,6 +423,26 @@ private:
 		bool _isPanoConstructed;
 
 		bool _dirty;
+
+		// Panoramas of the most recently visited nodes, most recent first,
+		// so that going back to a node doesn't decode all of its tiles again
+		struct CachedPanorama {
+			int sample;
+			Graphics::Surface *pano;
+			Graphics::Surface *hotspots;
+		};
+
+		Common::Array<CachedPanorama> _panoCache;
+
+		// The projection tables only depend on the view size, the field of
+		// view and the tilt, so they are kept while panning
+		Common::Array<float> _sideEdgeXYInterpolators;
+		Common::Array<float> _cylinderProjectionRanges;
+		Common::Array<float> _cylinderAngleOffsets;
+		uint16 _warpWidth;
+		uint16 _warpHeight;
+		float _warpFOV;
+		float _warpTiltAngle;
 	};
 };
 
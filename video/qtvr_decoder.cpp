@@ -56,6 +56,16 @@ namespace Video {
 
 static const char * const MACGUI_DATA_BUNDLE = "macgui.dat";
 
+// The number of node panoramas kept in memory
+static const uint kPanoramaCacheSize = 3;
+
+static void freeSurface(Graphics::Surface *surface) {
+	if (surface) {
+		surface->free();
+		delete surface;
+	}
+}
+
 static void repeatCallback(void *data);
 
 ////////////////////////////////////////////
@@ -487,16 +497,16 @@ QuickTimeDecoder::PanoTrackHandler::PanoTrackHandler(QuickTimeDecoder *decoder,
 
 	_dirty = true;
 
+	_warpWidth = _warpHeight = 0;
+	_warpFOV = _warpTiltAngle = 0.0f;
+
 	_decoder->updateQTVRCursor(0, 0); // Initialize all things for cursor
 }
 
 QuickTimeDecoder::PanoTrackHandler::~PanoTrackHandler() {
-	if (_isPanoConstructed) {
-		_constructedPano->free();
-		delete _constructedPano;
-
-		_constructedHotspots->free();
-		delete _constructedHotspots;
+	for (uint i = 0; i < _panoCache.size(); i++) {
+		freeSurface(_panoCache[i].pano);
+		freeSurface(_panoCache[i].hotspots);
 	}
 
 	if (_projectedPano) {
@@ -595,12 +605,22 @@ void QuickTimeDecoder::PanoTrackHandler::constructPanorama() {
 	PanoSampleDesc *desc = (PanoSampleDesc *)_parent->sampleDescs[0];
 	PanoTrackSample *sample = &_parent->panoSamples[_decoder->_currentSample];
 
-	if (_constructedPano) {
-		_constructedPano->free();
-		delete _constructedPano;
+	// Reuse the panorama of a recently visited node
+	for (uint i = 0; i < _panoCache.size(); i++) {
+		if (_panoCache[i].sample != _decoder->_currentSample)
+			continue;
+
+		CachedPanorama entry = _panoCache[i];
+		_panoCache.remove_at(i);
+		_panoCache.insert_at(0, entry);
+
+		debugC(1, kDebugLevelGVideo, "Node idx: %d (cached)", sample->hdr.nodeID);
 
-		_constructedHotspots->free();
-		delete _constructedHotspots;
+		_constructedPano = entry.pano;
+		_constructedHotspots = entry.hotspots;
+		_isPanoConstructed = true;
+		_dirty = true;
+		return;
 	}
 
 	debugC(1, kDebugLevelGVideo, "scene: %d (%d x %d) hotspots: %d (%d x %d)", desc->_sceneTrackID, desc->_sceneSizeX, desc->_sceneSizeY,
@@ -638,7 +658,21 @@ void QuickTimeDecoder::PanoTrackHandler::constructPanorama() {
 
 	_constructedHotspots = constructMosaic(track, desc->_hotSpotNumFramesX, desc->_hotSpotNumFramesY, "dumps/pano-hotspot.png");
 
+	CachedPanorama entry;
+	entry.sample = _decoder->_currentSample;
+	entry.pano = _constructedPano;
+	entry.hotspots = _constructedHotspots;
+	_panoCache.insert_at(0, entry);
+
+	// Drop the least recently visited panoramas
+	while (_panoCache.size() > kPanoramaCacheSize) {
+		freeSurface(_panoCache.back().pano);
+		freeSurface(_panoCache.back().hotspots);
+		_panoCache.pop_back();
+	}
+
 	_isPanoConstructed = true;
+	_dirty = true;
 }
 
 Common::Point QuickTimeDecoder::PanoTrackHandler::projectPoint(int16 mx, int16 my) {
@@ -722,23 +756,7 @@ Common::Point QuickTimeDecoder::PanoTrackHandler::projectPoint(int16 mx, int16 m
 	return Common::Point(hotX, hotY);
 }
 
-void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
-	if (!_isPanoConstructed)
-		return;
-
-	uint16 w = _decoder->getWidth(), h = _decoder->getHeight();
-
-	if (!_projectedPano) {
-		if (w == 0 || h == 0)
-			error("QuickTimeDecoder::PanoTrackHandler::projectPanorama(): setTargetSize() was not called");
-
-		_projectedPano = new Graphics::Surface();
-		_projectedPano->create(w, h, _constructedPano->format);
-
-		_planarProjection = new Graphics::Surface();
-		_planarProjection->create(w, h, _constructedPano->format);
-	}
-
+void QuickTimeDecoder::PanoTrackHandler::updateWarpTables(uint16 w, uint16 h) {
 	PanoSampleDesc *desc = (PanoSampleDesc *)_parent->sampleDescs[0];
 
 	float cornerVectors[2][3];
@@ -784,11 +802,9 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 	float minProjectedY = topRightVector[1] / topRightVector[2];
 	float maxProjectedY = bottomRightVector[1] / bottomRightVector[2];
 
-	Common::Array<float> sideEdgeXYInterpolators;
-
 	// The X interpolators are from 0 to maxProjectedX
 	// The Y interpolators are the interpolator from minProjectedY to maxProjectedY
-	sideEdgeXYInterpolators.resize(h * 2);
+	_sideEdgeXYInterpolators.resize(h * 2);
 
 	for (uint16 y = 0; y < h; y++) {
 		float t = ((float)y + 0.5f) / (float)h;
@@ -800,8 +816,8 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 			float projectedX = vector[0] / vector[2];
 			float projectedY = vector[1] / vector[2];
 
-			sideEdgeXYInterpolators[y * 2 + 0] = projectedX / maxProjectedX;
-			sideEdgeXYInterpolators[y * 2 + 1] = (projectedY - minProjectedY) / (maxProjectedY - minProjectedY);
+			_sideEdgeXYInterpolators[y * 2 + 0] = projectedX / maxProjectedX;
+			_sideEdgeXYInterpolators[y * 2 + 1] = (projectedY - minProjectedY) / (maxProjectedY - minProjectedY);
 		}
 	}
 
@@ -810,11 +826,8 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 
 	float halfWidthFloat = (float)w * 0.5f;
 
-	Common::Array<float> cylinderProjectionRanges;
-	Common::Array<float> cylinderAngleOffsets;
-
-	cylinderProjectionRanges.resize(halfWidthRoundedUp * 2);
-	cylinderAngleOffsets.resize(halfWidthRoundedUp);
+	_cylinderProjectionRanges.resize(halfWidthRoundedUp * 2);
+	_cylinderAngleOffsets.resize(halfWidthRoundedUp);
 
 	for (uint16 x = 0; x < halfWidthRoundedUp; x++) {
 		float xFloat = (float)x;
@@ -836,12 +849,42 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 
 			float newY = yCoords[v] / length;
 
-			cylinderProjectionRanges[x * 2 + v] = (newY - minTiltY) / (maxTiltY - minTiltY);
+			_cylinderProjectionRanges[x * 2 + v] = (newY - minTiltY) / (maxTiltY - minTiltY);
 		}
 
-		cylinderAngleOffsets[x] = atan(xCoord) * 0.5f / M_PI;
+		_cylinderAngleOffsets[x] = atan(xCoord) * 0.5f / M_PI;
 	}
 
+	_warpWidth = w;
+	_warpHeight = h;
+	_warpFOV = _decoder->_fov;
+	_warpTiltAngle = _decoder->_tiltAngle;
+}
+
+void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
+	if (!_isPanoConstructed)
+		return;
+
+	uint16 w = _decoder->getWidth(), h = _decoder->getHeight();
+
+	if (!_projectedPano) {
+		if (w == 0 || h == 0)
+			error("QuickTimeDecoder::PanoTrackHandler::projectPanorama(): setTargetSize() was not called");
+
+		_projectedPano = new Graphics::Surface();
+		_projectedPano->create(w, h, _constructedPano->format);
+
+		_planarProjection = new Graphics::Surface();
+		_planarProjection->create(w, h, _constructedPano->format);
+	}
+
+	if (w != _warpWidth || h != _warpHeight || _decoder->_fov != _warpFOV || _decoder->_tiltAngle != _warpTiltAngle)
+		updateWarpTables(w, h);
+
+	PanoSampleDesc *desc = (PanoSampleDesc *)_parent->sampleDescs[0];
+
+	uint16 halfWidthRoundedUp = (w + 1) / 2;
+
 	float angleT = fmod((360.0f - _decoder->_panAngle) / 360.0f, 1.0f);
 	if (angleT < 0.0f)
 		angleT += 1.0f;
@@ -857,13 +900,13 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 	for (uint16 projectionCol = 0; projectionCol < halfWidthRoundedUp; projectionCol++) {
 		int32 centerXImageCoord = static_cast<int32>(angleOffset);
 
-		int32 edgeCoordOffset = static_cast<int32>(cylinderAngleOffsets[projectionCol] * panoWidth);
+		int32 edgeCoordOffset = static_cast<int32>(_cylinderAngleOffsets[projectionCol] * panoWidth);
 
 		int32 leftSrcCoord = centerXImageCoord - edgeCoordOffset;
 		int32 rightSrcCoord = centerXImageCoord + edgeCoordOffset;
 
-		int32 topSrcCoord = static_cast<int32>(cylinderProjectionRanges[projectionCol * 2 + 0] * panoHeight);
-		int32 bottomSrcCoord = static_cast<int32>(cylinderProjectionRanges[projectionCol * 2 + 1] * panoHeight);
+		int32 topSrcCoord = static_cast<int32>(_cylinderProjectionRanges[projectionCol * 2 + 0] * panoHeight);
+		int32 bottomSrcCoord = static_cast<int32>(_cylinderProjectionRanges[projectionCol * 2 + 1] * panoHeight);
 
 		if (topSrcCoord < 0)
 			topSrcCoord = 0;
@@ -894,9 +937,13 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 		uint16 x1 = halfWidthRoundedUp - 1 - projectionCol;
 		uint16 x2 = w - halfWidthRoundedUp + projectionCol;
 
-		for (uint16 y = 0; y < h; y++) {
-			int32 sourceYCoord = (2 * y + 1) * (bottomSrcCoord - topSrcCoord) / (2 * h) + topSrcCoord;
+		// Step through the source rows, (2 * y + 1) * span / (2 * h) + topSrcCoord,
+		// without dividing for every pixel. The span is never negative.
+		const int32 span = bottomSrcCoord - topSrcCoord;
+		int32 sourceYCoord = topSrcCoord + span / (2 * h);
+		int32 sourceYRemainder = span % (2 * h);
 
+		for (uint16 y = 0; y < h; y++) {
 			uint32 pixel1 = srcSurf->getPixel(sourceYCoord, leftSrcCoord);
 			uint32 pixel2 = srcSurf->getPixel(sourceYCoord, rightSrcCoord);
 
@@ -909,25 +956,39 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 
 			_planarProjection->setPixel(x1, y, pixel1);
 			_planarProjection->setPixel(x2, y, pixel2);
+
+			sourceYRemainder += 2 * span;
+			while (sourceYRemainder >= 2 * h) {
+				sourceYRemainder -= 2 * h;
+				sourceYCoord++;
+			}
 		}
 	}
 
 	// Convert planar projection into perspective projection
 	for (uint16 y = 0; y < h; y++) {
-		float xInterpolator = sideEdgeXYInterpolators[y * 2 + 0];
-		float yInterpolator = sideEdgeXYInterpolators[y * 2 + 1];
+		float xInterpolator = _sideEdgeXYInterpolators[y * 2 + 0];
+		float yInterpolator = _sideEdgeXYInterpolators[y * 2 + 1];
 
 		int32 srcY = static_cast<int32>(yInterpolator * (float)h);
 		int32 scanlineWidth = static_cast<int32>(xInterpolator * w) / 2 * 2;
 		int32 startX = (w - scanlineWidth) / 2;
 		//int32 endX = startX + scanlineWidth;
 
-		// It would be better to compute a reciprocal and do this as a multiply instead,
-		// doing divides per pixel is SLOW!
+		// Step through the source columns, (2 * x + 1) * scanlineWidth / (2 * w) + startX,
+		// instead of dividing for every pixel
+		int32 srcX = startX + scanlineWidth / (2 * w);
+		int32 srcXRemainder = scanlineWidth % (2 * w);
+
 		for (uint16 x = 0; x < w; x++) {
-			int32 srcX = (2 * x + 1) * scanlineWidth / (2 * w) + startX;
 			uint32 pixel = _planarProjection->getPixel(srcX, srcY);
 			_projectedPano->setPixel(x, y, pixel);
+
+			srcXRemainder += 2 * scanlineWidth;
+			while (srcXRemainder >= 2 * w) {
+				srcXRemainder -= 2 * w;
+				srcX++;
+			}
 		}
 	}
 
@@ -68,13 +68,19 @@ private:
 		SMK_NODE = 0x8000
 	};
 
+	enum {
+		SMK_LOOKUP_BITS = 10
+	};
+
 	uint16 decodeTree(uint32 prefix, int length);
 
 	uint16 _treeSize;
 	uint16 _tree[511];
 
-	uint16 _prefixtree[256];
-	byte _prefixlength[256];
+	// Tree entry and code length for every SMK_LOOKUP_BITS-bit value, so
+	// that most codes are resolved by a single table lookup
+	uint16 _prefixtree[1 << SMK_LOOKUP_BITS];
+	byte _prefixlength[1 << SMK_LOOKUP_BITS];
 
 	SmackerBitStream &_bs;
 	bool _empty;
@@ -87,7 +93,7 @@ SmallHuffmanTree::SmallHuffmanTree(SmackerBitStream &bs)
 		return;
 	}
 
-	for (uint16 i = 0; i < 256; ++i)
+	for (uint16 i = 0; i < (1 << SMK_LOOKUP_BITS); ++i)
 		_prefixtree[i] = _prefixlength[i] = 0;
 
 	decodeTree(0, 0);
@@ -102,8 +108,8 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 	if (!_bs.getBit()) { // Leaf
 		_tree[_treeSize] = _bs.getBits<8>();
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= SMK_LOOKUP_BITS) {
+			for (int i = 0; i < (1 << SMK_LOOKUP_BITS); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -115,9 +121,9 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint16 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == SMK_LOOKUP_BITS) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = SMK_LOOKUP_BITS;
 	}
 
 	uint16 r1 = decodeTree(prefix, length + 1);
@@ -136,7 +142,7 @@ uint16 SmallHuffmanTree::getCode(SmackerBitStream &bs) {
 	// Peeking data out of bounds is well-defined and returns 0 bits.
 	// This is for convenience when using speed-up techniques reading
 	// more bits than actually available.
-	byte peek = bs.peekBits<8>();
+	uint32 peek = bs.peekBits<SMK_LOOKUP_BITS>();
 	uint16 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -149,6 +155,151 @@ uint16 SmallHuffmanTree::getCode(SmackerBitStream &bs) {
 	return *p;
 }
 
+/*
+ * class SmackerDPCMStream
+ * An audio stream for a Huffman DPCM compressed audio packet. The packet
+ * is only unpacked when the mixer first reads from the stream, so audio
+ * is decoded in the mixer's thread instead of with the video frames.
+ */
+
+class SmackerDPCMStream : public Audio::AudioStream {
+public:
+	SmackerDPCMStream(byte *buffer, uint32 bufferSize, uint32 unpackedSize, uint32 rate, bool isStereo, bool is16Bits);
+	~SmackerDPCMStream();
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+	bool isStereo() const override { return _isStereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override;
+
+private:
+	void unpack();
+
+	byte *_buffer;
+	uint32 _bufferSize;
+	uint32 _unpackedSize;
+	uint32 _rate;
+	bool _isStereo;
+	bool _is16Bits;
+
+	Audio::AudioStream *_stream;
+};
+
+SmackerDPCMStream::SmackerDPCMStream(byte *buffer, uint32 bufferSize, uint32 unpackedSize, uint32 rate, bool isStereo, bool is16Bits)
+	: _buffer(buffer), _bufferSize(bufferSize), _unpackedSize(unpackedSize), _rate(rate),
+	  _isStereo(isStereo), _is16Bits(is16Bits), _stream(nullptr) {
+}
+
+SmackerDPCMStream::~SmackerDPCMStream() {
+	free(_buffer);
+	delete _stream;
+}
+
+int SmackerDPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	if (_buffer)
+		unpack();
+
+	return _stream ? _stream->readBuffer(buffer, numSamples) : 0;
+}
+
+bool SmackerDPCMStream::endOfData() const {
+	if (_buffer)
+		return _unpackedSize == 0;
+
+	return !_stream || _stream->endOfData();
+}
+
+void SmackerDPCMStream::unpack() {
+	// The bit stream takes over the packed data, which is freed once it is unpacked
+	SmackerBitStream audioBS(new Common::BitStreamMemoryStream(_buffer, _bufferSize, DisposeAfterUse::YES), DisposeAfterUse::YES);
+	_buffer = nullptr;
+
+	bool dataPresent = audioBS.getBit();
+
+	if (!dataPresent)
+		return;
+
+	bool isStereo = audioBS.getBit();
+	assert(isStereo == _isStereo);
+	bool is16Bits = audioBS.getBit();
+	assert(is16Bits == _is16Bits);
+
+	int numBytes = 1 * (isStereo ? 2 : 1) * (is16Bits ? 2 : 1);
+
+	byte *unpackedBuffer = (byte *)malloc(_unpackedSize);
+	byte *curPointer = unpackedBuffer;
+	uint32 curPos = 0;
+
+	SmallHuffmanTree *audioTrees[4];
+	for (int k = 0; k < numBytes; k++)
+		audioTrees[k] = new SmallHuffmanTree(audioBS);
+
+	// Base values, stored as big endian
+
+	int32 bases[2];
+
+	if (isStereo) {
+		if (is16Bits) {
+			bases[1] = SWAP_BYTES_16(audioBS.getBits<16>());
+		} else {
+			bases[1] = audioBS.getBits<8>();
+		}
+	}
+
+	if (is16Bits) {
+		bases[0] = SWAP_BYTES_16(audioBS.getBits<16>());
+	} else {
+		bases[0] = audioBS.getBits<8>();
+	}
+
+	// The bases are the first samples, too
+	for (int i = 0; i < (isStereo ? 2 : 1); i++, curPointer += (is16Bits ? 2 : 1), curPos += (is16Bits ? 2 : 1)) {
+		if (is16Bits)
+			WRITE_BE_UINT16(curPointer, bases[i]);
+		else
+			*curPointer = (bases[i] & 0xFF) ^ 0x80;
+	}
+
+	// Next follow the deltas, which are added to the corresponding base values and
+	// are stored as little endian
+	// We store the unpacked bytes in big endian format
+
+	while (curPos < _unpackedSize) {
+		// If the sample is stereo, the data is stored for the left and right channel, respectively
+		// (the exact opposite to the base values)
+		if (!is16Bits) {
+			for (int k = 0; k < (isStereo ? 2 : 1); k++) {
+				int8 delta = (int8) ((int16) audioTrees[k]->getCode(audioBS));
+				bases[k] = (bases[k] + delta) & 0xFF;
+				*curPointer++ = bases[k] ^ 0x80;
+				curPos++;
+			}
+		} else {
+			for (int k = 0; k < (isStereo ? 2 : 1); k++) {
+				byte lo = audioTrees[k * 2]->getCode(audioBS);
+				byte hi = audioTrees[k * 2 + 1]->getCode(audioBS);
+				bases[k] += (int16) (lo | (hi << 8));
+
+				WRITE_BE_UINT16(curPointer, bases[k]);
+				curPointer += 2;
+				curPos += 2;
+			}
+		}
+
+	}
+
+	for (int k = 0; k < numBytes; k++)
+		delete audioTrees[k];
+
+	byte flags = 0;
+	if (is16Bits)
+		flags |= Audio::FLAG_16BITS;
+	if (isStereo)
+		flags |= Audio::FLAG_STEREO;
+
+	_stream = Audio::makeRawStream(unpackedBuffer, _unpackedSize, _rate, flags, DisposeAfterUse::YES);
+}
+
 /*
  * class BigHuffmanTree
  * A Huffman-tree to hold 16-bit values.
@@ -166,14 +317,20 @@ private:
 		SMK_NODE = 0x80000000
 	};
 
+	enum {
+		SMK_LOOKUP_BITS = 12
+	};
+
 	uint32 decodeTree(uint32 prefix, int length);
 
 	uint32  _treeSize;
 	uint32 *_tree;
 	uint32  _last[3];
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+	// Tree entry and code length for every SMK_LOOKUP_BITS-bit value, so
+	// that most codes are resolved by a single table lookup
+	uint32 _prefixtree[1 << SMK_LOOKUP_BITS];
+	byte _prefixlength[1 << SMK_LOOKUP_BITS];
 
 	/* Used during construction */
 	SmackerBitStream &_bs;
@@ -184,6 +341,10 @@ private:
 
 BigHuffmanTree::BigHuffmanTree(SmackerBitStream &bs, int allocSize)
 	: _bs(bs) {
+	// An empty tree maps every code to its single entry, without reading any bits
+	for (uint32 i = 0; i < (1 << SMK_LOOKUP_BITS); ++i)
+		_prefixtree[i] = _prefixlength[i] = 0;
+
 	uint32 bit = _bs.getBit();
 	if (!bit) {
 		_tree = new uint32[1];
@@ -192,9 +353,6 @@ BigHuffmanTree::BigHuffmanTree(SmackerBitStream &bs, int allocSize)
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
 	_loBytes = new SmallHuffmanTree(_bs);
 	_hiBytes = new SmallHuffmanTree(_bs);
 
@@ -239,8 +397,8 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 		_tree[_treeSize] = v;
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= SMK_LOOKUP_BITS) {
+			for (int i = 0; i < (1 << SMK_LOOKUP_BITS); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -259,9 +417,9 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint32 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == SMK_LOOKUP_BITS) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = SMK_LOOKUP_BITS;
 	}
 
 	uint32 r1 = decodeTree(prefix, length + 1);
@@ -276,7 +434,7 @@ uint32 BigHuffmanTree::getCode(SmackerBitStream &bs) {
 	// Peeking data out of bounds is well-defined and returns 0 bits.
 	// This is for convenience when using speed-up techniques reading
 	// more bits than actually available.
-	byte peek = bs.peekBits<8>();
+	uint32 peek = bs.peekBits<SMK_LOOKUP_BITS>();
 	uint32 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -579,7 +737,6 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 		} else if (_header.audioInfo[track].compression == kCompressionDPCM) {
 			// Compressed audio (Huffman DPCM encoded)
 			audioTrack->queueCompressedBuffer(soundBuffer, chunkSize + 1, unpackedSize);
-			free(soundBuffer);
 		} else {
 			// Uncompressed audio (PCM)
 			audioTrack->queuePCM(soundBuffer, chunkSize);
@@ -865,85 +1022,7 @@ Audio::AudioStream *SmackerDecoder::SmackerAudioTrack::getAudioStream() const {
 }
 
 void SmackerDecoder::SmackerAudioTrack::queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize) {
-	SmackerBitStream audioBS(new Common::BitStreamMemoryStream(buffer, bufferSize), DisposeAfterUse::YES);
-	bool dataPresent = audioBS.getBit();
-
-	if (!dataPresent)
-		return;
-
-	bool isStereo = audioBS.getBit();
-	assert(isStereo == _audioInfo.isStereo);
-	bool is16Bits = audioBS.getBit();
-	assert(is16Bits == _audioInfo.is16Bits);
-
-	int numBytes = 1 * (isStereo ? 2 : 1) * (is16Bits ? 2 : 1);
-
-	byte *unpackedBuffer = (byte *)malloc(unpackedSize);
-	byte *curPointer = unpackedBuffer;
-	uint32 curPos = 0;
-
-	SmallHuffmanTree *audioTrees[4];
-	for (int k = 0; k < numBytes; k++)
-		audioTrees[k] = new SmallHuffmanTree(audioBS);
-
-	// Base values, stored as big endian
-
-	int32 bases[2];
-
-	if (isStereo) {
-		if (is16Bits) {
-			bases[1] = SWAP_BYTES_16(audioBS.getBits<16>());
-		} else {
-			bases[1] = audioBS.getBits<8>();
-		}
-	}
-
-	if (is16Bits) {
-		bases[0] = SWAP_BYTES_16(audioBS.getBits<16>());
-	} else {
-		bases[0] = audioBS.getBits<8>();
-	}
-
-	// The bases are the first samples, too
-	for (int i = 0; i < (isStereo ? 2 : 1); i++, curPointer += (is16Bits ? 2 : 1), curPos += (is16Bits ? 2 : 1)) {
-		if (is16Bits)
-			WRITE_BE_UINT16(curPointer, bases[i]);
-		else
-			*curPointer = (bases[i] & 0xFF) ^ 0x80;
-	}
-
-	// Next follow the deltas, which are added to the corresponding base values and
-	// are stored as little endian
-	// We store the unpacked bytes in big endian format
-
-	while (curPos < unpackedSize) {
-		// If the sample is stereo, the data is stored for the left and right channel, respectively
-		// (the exact opposite to the base values)
-		if (!is16Bits) {
-			for (int k = 0; k < (isStereo ? 2 : 1); k++) {
-				int8 delta = (int8) ((int16) audioTrees[k]->getCode(audioBS));
-				bases[k] = (bases[k] + delta) & 0xFF;
-				*curPointer++ = bases[k] ^ 0x80;
-				curPos++;
-			}
-		} else {
-			for (int k = 0; k < (isStereo ? 2 : 1); k++) {
-				byte lo = audioTrees[k * 2]->getCode(audioBS);
-				byte hi = audioTrees[k * 2 + 1]->getCode(audioBS);
-				bases[k] += (int16) (lo | (hi << 8));
-
-				WRITE_BE_UINT16(curPointer, bases[k]);
-				curPointer += 2;
-				curPos += 2;
-			}
-		}
-
-	}
-
-	for (int k = 0; k < numBytes; k++)
-		delete audioTrees[k];
-
-	queuePCM(unpackedBuffer, unpackedSize);
+	_audioStream->queueAudioStream(new SmackerDPCMStream(buffer, bufferSize, unpackedSize, _audioInfo.sampleRate, _audioInfo.isStereo, _audioInfo.is16Bits), DisposeAfterUse::YES);
 }
 
 void SmackerDecoder::SmackerAudioTrack::queuePCM(byte *buffer, uint32 bufferSize) {
@@ -287,6 +287,15 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_
 	_curFrame = -1;
 	_surface = nullptr;
 	_displaySurface = nullptr;
+
+	// Have the decoder hand us each band of rows as soon as it is finished,
+	// so that it gets converted while it is still in the cache
+	th_stripe_callback stripeCallback;
+	stripeCallback.ctx = this;
+	stripeCallback.stripe_decoded = stripeDecoded;
+	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_STRIPE_CB, &stripeCallback, sizeof(stripeCallback));
+	_stripeRowsConverted.resize((_surfaceHeight + 7) / 8);
+	_stripeRowsLeft = _stripeRowsConverted.size();
 }
 
 TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
@@ -306,13 +315,20 @@ TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
 }
 
 bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket) {
+	for (uint i = 0; i < _stripeRowsConverted.size(); i++)
+		_stripeRowsConverted[i] = false;
+	_stripeRowsLeft = _stripeRowsConverted.size();
+
 	if (th_decode_packetin(_theoraDecode, &oggPacket, 0) == 0) {
 		_curFrame++;
 
-		// Convert YUV data to RGB data
+		// Convert YUV data to RGB data, unless the stripe callback already
+		// converted the whole frame. Converting all of it again is the
+		// fallback for anything the stripes didn't cover.
 		th_ycbcr_buffer yuv;
 		th_decode_ycbcr_out(_theoraDecode, yuv);
-		translateYUVtoRGBA(yuv);
+		if (_stripeRowsLeft != 0)
+			translateYUVtoRGBA(yuv, 0, yuv[0].height);
 
 		double time = th_granule_time(_theoraDecode, oggPacket.granulepos);
 
@@ -337,7 +353,28 @@ enum TheoraYUVBuffers {
 	kBufferV = 2
 };
 
-void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer) {
+void TheoraDecoder::TheoraVideoTrack::stripeDecoded(void *ctx, th_ycbcr_buffer buf, int yfrag0, int yfragEnd) {
+	// Fragment rows are 8 pixels high. With vertically subsampled chroma,
+	// they always come in pairs, so each band holds whole chroma rows.
+	TheoraVideoTrack *track = (TheoraVideoTrack *)ctx;
+	yfrag0 = MAX(yfrag0, 0);
+	yfragEnd = MIN<int>(yfragEnd, track->_stripeRowsConverted.size());
+	if (yfrag0 >= yfragEnd)
+		return;
+
+	track->translateYUVtoRGBA(buf, yfrag0 * 8, MIN<int>(yfragEnd * 8, buf[kBufferY].height));
+
+	// libtheora decodes from the bottom of the picture up, so the stripes
+	// arrive bottom to top. Keep track of the rows in any order.
+	for (int i = yfrag0; i < yfragEnd; i++) {
+		if (!track->_stripeRowsConverted[i]) {
+			track->_stripeRowsConverted[i] = true;
+			track->_stripeRowsLeft--;
+		}
+	}
+}
+
+void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_img_plane *YUVBuffer, int top, int bottom) {
 	// Width and height of all buffers have to be divisible by 2.
 	assert((YUVBuffer[kBufferY].width & 1) == 0);
 	assert((YUVBuffer[kBufferY].height & 1) == 0);
@@ -362,15 +399,25 @@ void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuf
 		                      _surface->getBasePtr(_x, _y), _surface->format);
 	}
 
+	if (top >= bottom)
+		return;
+
+	// Only convert the rows from top to bottom
+	const int uvTop = (YUVBuffer[kBufferU].height == YUVBuffer[kBufferY].height) ? top : (top >> 1);
+	const byte *ySrc = YUVBuffer[kBufferY].data + top * YUVBuffer[kBufferY].stride;
+	const byte *uSrc = YUVBuffer[kBufferU].data + uvTop * YUVBuffer[kBufferU].stride;
+	const byte *vSrc = YUVBuffer[kBufferV].data + uvTop * YUVBuffer[kBufferV].stride;
+	Graphics::Surface dst = _surface->getSubArea(Common::Rect(0, top, _surface->w, bottom));
+
 	switch (_theoraPixelFormat) {
 	case TH_PF_420:
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+		YUVToRGBMan.convert420(&dst, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, YUVBuffer[kBufferY].width, bottom - top, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
 		break;
 	case TH_PF_422:
-		YUVToRGBMan.convert422(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+		YUVToRGBMan.convert422(&dst, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, YUVBuffer[kBufferY].width, bottom - top, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
 		break;
 	case TH_PF_444:
-		YUVToRGBMan.convert444(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+		YUVToRGBMan.convert444(&dst, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, YUVBuffer[kBufferY].width, bottom - top, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
 		break;
 	default:
 		error("Unsupported Theora pixel format");
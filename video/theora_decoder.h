@@ -26,6 +26,7 @@
 #ifndef VIDEO_THEORA_DECODER_H
 #define VIDEO_THEORA_DECODER_H
 
+#include "common/array.h"
 #include "common/rational.h"
 #include "video/video_decoder.h"
 #include "audio/mixer.h"
@@ -119,8 +120,11 @@ private:
 
 		th_dec_ctx *_theoraDecode;
 		th_pixel_fmt _theoraPixelFormat;
+		Common::Array<bool> _stripeRowsConverted; ///< The fragment rows of the current frame converted by stripeDecoded()
+		uint _stripeRowsLeft; ///< The number of fragment rows stripeDecoded() has yet to convert
 
-		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
+		static void stripeDecoded(void *ctx, th_ycbcr_buffer buf, int yfrag0, int yfragEnd);
+		void translateYUVtoRGBA(th_img_plane *YUVBuffer, int top, int bottom);
 	};
 
 	class VorbisAudioTrack : public AudioTrack {
@@ -26,7 +26,10 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/rect.h"
 #include "common/system.h"
+#include "graphics/blit.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
@@ -48,6 +51,8 @@ VideoDecoder::VideoDecoder() {
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+	_frameQueueHead = 0;
+	_frameQueueCount = 0;
 }
 
 void VideoDecoder::close() {
@@ -74,6 +79,7 @@ void VideoDecoder::close() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	freeFrameQueue();
 }
 
 bool VideoDecoder::loadFile(const Common::Path &filename) {
@@ -114,9 +120,11 @@ bool VideoDecoder::needsUpdate() const {
 }
 
 void VideoDecoder::delayMillis(uint msecs) {
-	if (!needsUpdate())
+	if (!needsUpdate()) {
+		// Use the time until the next frame to decode ahead
+		decodeAhead();
 		g_system->delayMillis(MIN<uint>(msecs, getTimeToNextFrame()));
-	else
+	} else
 		g_system->delayMillis(1); /* This is needed to keep the mixer and timers active */
 }
 
@@ -212,6 +220,29 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (_frameQueue.empty())
+		return decodeFrameIntern();
+
+	// Hand out the oldest frame decoded ahead, or decode one now
+	if (_frameQueueCount == 0 && !queueNextFrame())
+		return 0;
+
+	QueuedFrame &frame = _frameQueue[_frameQueueHead];
+	_frameQueueHead = (_frameQueueHead + 1) % _frameQueue.size();
+	_frameQueueCount--;
+
+	// The slot is reused by the frames decoded after this one, so keep a
+	// copy of the palette for getPalette()
+	if (frame.dirtyPalette) {
+		memcpy(_queuedPalette, frame.palette, sizeof(_queuedPalette));
+		_palette = _queuedPalette;
+		_dirtyPalette = true;
+	}
+
+	return frame.hasSurface ? frame.surface : 0;
+}
+
+const Graphics::Surface *VideoDecoder::decodeFrameIntern() {
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -232,11 +263,93 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+bool VideoDecoder::decodeNextFrameToScreen(int x, int y) {
+	// Let the track decode straight into the screen if it can. Frames
+	// decoded ahead already have a surface of their own.
+	VideoTrack *track = _nextVideoTrack;
+	if (_frameQueue.empty() && track && track->canSetFrameTarget(g_system->getScreenFormat())) {
+		const Common::Rect area(x, y, x + track->getWidth(), y + track->getHeight());
+
+		if (area.left >= 0 && area.top >= 0 && area.right <= g_system->getWidth() && area.bottom <= g_system->getHeight()) {
+			Graphics::Surface *screen = g_system->lockScreen();
+
+			if (screen) {
+				Graphics::Surface target = screen->getSubArea(area);
+				track->setFrameTarget(&target);
+				const Graphics::Surface *frame = decodeNextFrame();
+				track->setFrameTarget(0);
+
+				g_system->unlockScreenRect(frame ? area : Common::Rect());
+				return frame != 0;
+			}
+		}
+	}
+
+	const Graphics::Surface *frame = decodeNextFrame();
+	return frame && drawFrameToScreen(frame, x, y);
+}
+
+bool VideoDecoder::drawFrameToScreen(const Graphics::Surface *frame, int x, int y) {
+	Common::Rect area(x, y, x + frame->w, y + frame->h);
+	area.clip(Common::Rect(g_system->getWidth(), g_system->getHeight()));
+	if (area.isEmpty())
+		return false;
+
+	const Graphics::Surface src = frame->getSubArea(Common::Rect(area.left - x, area.top - y, area.right - x, area.bottom - y));
+	const Graphics::PixelFormat screenFormat = g_system->getScreenFormat();
+
+	if (src.format == screenFormat) {
+		g_system->copyRectToScreen(src.getPixels(), src.pitch, area.left, area.top, src.w, src.h);
+		return true;
+	}
+
+	// High color frames cannot be shown on a paletted screen
+	if (screenFormat.bytesPerPixel == 1)
+		return false;
+
+	uint32 map[256];
+	if (src.format.bytesPerPixel == 1) {
+		if (!_palette)
+			return false;
+
+		Graphics::convertPaletteToMap(map, _palette, 256, screenFormat);
+	}
+
+	Graphics::Surface *screen = g_system->lockScreen();
+	if (!screen)
+		return false;
+
+	byte *dst = (byte *)screen->getBasePtr(area.left, area.top);
+	bool converted;
+	if (src.format.bytesPerPixel == 1)
+		converted = Graphics::crossBlitMap(dst, (const byte *)src.getPixels(), screen->pitch, src.pitch, src.w, src.h, screenFormat.bytesPerPixel, map);
+	else
+		converted = Graphics::crossBlit(dst, (const byte *)src.getPixels(), screen->pitch, src.pitch, src.w, src.h, screenFormat, src.format);
+
+	g_system->unlockScreenRect(converted ? area : Common::Rect());
+	return converted;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// Frames decoded ahead are of no use backwards, so put the tracks
+	// back at the frame after the one being shown
+	if (reverse && _frameQueueCount != 0) {
+		if (!isSeekable() || !_nextVideoTrack)
+			return false;
+
+		Audio::Timestamp time = _nextVideoTrack->getFrameTime(getCurFrame() + 1);
+		if (time < 0)
+			return false;
+
+		clearFrameQueue();
+		if (!seekIntern(time))
+			return false;
+	}
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -263,7 +376,8 @@ int VideoDecoder::getCurFrame() const {
 		if (track->getTrackType() == Track::kTrackTypeVideo)
 			frame += ((VideoTrack *)track)->getCurFrame() + 1;
 
-	return frame;
+	// The tracks are ahead by the frames which haven't been handed out yet
+	return frame - _frameQueueCount;
 }
 
 uint32 VideoDecoder::getFrameCount() const {
@@ -298,10 +412,17 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	if (endOfVideo() || _needsUpdate || (!_nextVideoTrack && _frameQueueCount == 0))
 		return 0;
 
 	uint32 currentTime = getTime();
+
+	if (_frameQueueCount != 0) {
+		// Frames are only decoded ahead when playing forward
+		uint32 queuedFrameStartTime = _frameQueue[_frameQueueHead].startTime;
+		return (queuedFrameStartTime <= currentTime) ? 0 : queuedFrameStartTime - currentTime;
+	}
+
 	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
 
 	if (_nextVideoTrack->isReversed()) {
@@ -320,6 +441,9 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	if (_frameQueueCount != 0 && !isQueuedFrameAfterEnd())
+		return false;
+
 	for (const auto &track : _tracks) {
 		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
 		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
@@ -360,6 +484,7 @@ bool VideoDecoder::rewind() {
 	_lastTimeChange = 0;
 	_startTime = g_system->getMillis();
 	resetPauseStartTime();
+	clearFrameQueue();
 	findNextVideoTrack();
 	return true;
 }
@@ -402,6 +527,7 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	}
 
 	resetPauseStartTime();
+	clearFrameQueue();
 	findNextVideoTrack();
 	_needsUpdate = true;
 	return true;
@@ -574,6 +700,96 @@ bool VideoDecoder::setOutputPixelFormats(const Common::List<Graphics::PixelForma
 	return false;
 }
 
+bool VideoDecoder::setDecodeAhead(uint frames) {
+	// Like the output format, this can't change once frames are decoded
+	if (!_canSetDefaultFormat)
+		return false;
+
+	freeFrameQueue();
+
+	if (frames == 0)
+		return true;
+
+	_frameQueue.resize(frames + 1);
+	for (auto &frame : _frameQueue) {
+		frame.surface = 0;
+		frame.hasSurface = false;
+		frame.startTime = 0;
+		frame.dirtyPalette = false;
+	}
+
+	return true;
+}
+
+bool VideoDecoder::queueNextFrame() {
+	// The start time is read first, in the same way as getTimeToNextFrame()
+	// would have done without decoding ahead
+	uint32 startTime = _nextVideoTrack ? _nextVideoTrack->getNextFrameStartTime() : 0;
+
+	readNextPacket();
+
+	if (!_nextVideoTrack)
+		return false;
+
+	QueuedFrame &frame = _frameQueue[(_frameQueueHead + _frameQueueCount) % _frameQueue.size()];
+	const Graphics::Surface *surface = _nextVideoTrack->decodeNextFrame();
+
+	frame.startTime = startTime;
+	frame.hasSurface = (surface != 0);
+	if (surface) {
+		if (!frame.surface)
+			frame.surface = new Graphics::Surface();
+
+		if (frame.surface->w != surface->w || frame.surface->h != surface->h || frame.surface->format != surface->format) {
+			frame.surface->free();
+			frame.surface->create(surface->w, surface->h, surface->format);
+		}
+
+		frame.surface->copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.dirtyPalette = _nextVideoTrack->hasDirtyPalette();
+	if (frame.dirtyPalette)
+		memcpy(frame.palette, _nextVideoTrack->getPalette(), sizeof(frame.palette));
+
+	_frameQueueCount++;
+	findNextVideoTrack();
+	return true;
+}
+
+void VideoDecoder::decodeAhead() {
+	// Only decode ahead once playback has started, and only forward. One
+	// frame at a time keeps the time spent here short.
+	if (_frameQueue.empty() || _canSetDither || _frameQueueCount + 1 >= _frameQueue.size())
+		return;
+
+	if (!_nextVideoTrack || _nextVideoTrack->isReversed() || !hasTrackFramesLeft())
+		return;
+
+	queueNextFrame();
+}
+
+void VideoDecoder::clearFrameQueue() {
+	_frameQueueHead = 0;
+	_frameQueueCount = 0;
+}
+
+void VideoDecoder::freeFrameQueue() {
+	for (auto &frame : _frameQueue) {
+		if (frame.surface) {
+			frame.surface->free();
+			delete frame.surface;
+		}
+	}
+
+	_frameQueue.clear();
+	clearFrameQueue();
+}
+
+bool VideoDecoder::isQueuedFrameAfterEnd() const {
+	return isPlaying() && _endTimeSet && _frameQueue[_frameQueueHead].startTime >= (uint)_endTime.msecs();
+}
+
 void VideoDecoder::setVideoCodecAccuracy(Image::CodecAccuracy accuracy) {
 	_videoCodecAccuracy = accuracy;
 
@@ -948,7 +1164,7 @@ void VideoDecoder::setEndFrame(uint frame) {
 
 void VideoDecoder::resetStartTime() {
 	if (_nextVideoTrack) {
-		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
+		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame() - _frameQueueCount);
 		if (isPlaying()) {
 			_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
 		}
@@ -1032,6 +1248,13 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
+	if (_frameQueueCount != 0)
+		return !isQueuedFrameAfterEnd();
+
+	return hasTrackFramesLeft();
+}
+
+bool VideoDecoder::hasTrackFramesLeft() const {
 	for (const auto &track : _tracks) {
 		if (track->getTrackType() != Track::kTrackTypeVideo)
 			continue;
@@ -365,6 +365,29 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame and draw it onto the screen, with its top left
+	 * corner at the given position.
+	 *
+	 * Tracks which support it decode straight into the locked screen
+	 * framebuffer, which saves converting the frame into a surface of the
+	 * caller and copying that onto the screen. For the other tracks, the
+	 * frame is converted to the screen format while it is being copied.
+	 * Paletted frames are converted with the current palette of the video
+	 * when the screen is not paletted. On a paletted screen, setting the
+	 * palette is up to the caller, as usual.
+	 *
+	 * Only the area of the frame is marked as dirty, and the caller still
+	 * has to call OSystem::updateScreen(). Subclasses which change the frames
+	 * in decodeNextFrame() should not use this.
+	 *
+	 * @param x  the x coordinate of the frame on the screen
+	 * @param y  the y coordinate of the frame on the screen
+	 * @return whether a frame was drawn
+	 * @note when this returns false, the last frame should be kept on screen
+	 */
+	bool decodeNextFrameToScreen(int x, int y);
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -424,6 +447,36 @@ public:
 	 */
 	virtual void setVideoCodecAccuracy(Image::CodecAccuracy accuracy);
 
+	/**
+	 * Decode up to the given number of frames ahead of the one being shown.
+	 *
+	 * The frames are decoded by decodeAhead() and delayMillis() while the
+	 * next frame is not due yet, so that a frame which is slow to decode uses
+	 * up time the caller would have waited anyway. decodeNextFrame() then hands out
+	 * the oldest decoded frame. Each queued frame keeps a copy of the
+	 * surface and palette. The default is 0, which decodes every frame when
+	 * it is asked for.
+	 *
+	 * Frames are only decoded ahead when playing forward: setReverse()
+	 * discards them and puts the tracks back at the frame being shown.
+	 * Subclasses which look at the track state in decodeNextFrame() should
+	 * not use this.
+	 *
+	 * This should be called after loadStream(), but before a decodeNextFrame()
+	 * call. This setting remains until close() is called.
+	 *
+	 * @param frames the number of frames to decode ahead
+	 * @return true on success, false otherwise
+	 */
+	bool setDecodeAhead(uint frames);
+
+	/**
+	 * Decode one more frame ahead, if setDecodeAhead() was used and there is
+	 * room left for it. Callers which wait for needsUpdate() to return true
+	 * without calling delayMillis() should call this while waiting.
+	 */
+	void decodeAhead();
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -646,6 +699,25 @@ protected:
 		 */
 		virtual const Graphics::Surface *decodeNextFrame() = 0;
 
+		/**
+		 * Can the track decode its frames straight into a surface of the
+		 * given format? See setFrameTarget().
+		 */
+		virtual bool canSetFrameTarget(const Graphics::PixelFormat &format) const { return false; }
+
+		/**
+		 * Decode the following frames into the given surface, instead of
+		 * the track's own one. The surface has the size of the track and a
+		 * format for which canSetFrameTarget() returned true. Passing 0 goes
+		 * back to the track's own surface.
+		 *
+		 * @note While a target is set, the surface returned by
+		 * decodeNextFrame() does not hold the decoded frame.
+		 *
+		 * @see VideoDecoder::decodeNextFrameToScreen()
+		 */
+		virtual void setFrameTarget(Graphics::Surface *target) {}
+
 		/**
 		 * Get the palette currently in use by this track
 		 */
@@ -1009,11 +1081,35 @@ private:
 	// Palette settings from individual tracks
 	mutable bool _dirtyPalette;
 	const byte *_palette;
+	byte _queuedPalette[256 * 3]; ///< The palette of the last frame handed out from _frameQueue
 
 	// Enforcement of not being able to set dither or set the default format
 	bool _canSetDither;
 	bool _canSetDefaultFormat;
 
+	// Frames decoded ahead of time, see setDecodeAhead()
+	struct QueuedFrame {
+		Graphics::Surface *surface;
+		bool hasSurface;
+		uint32 startTime;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	// A ring buffer with one slot more than the decode-ahead count, so that
+	// the frame handed out last stays valid while the next ones are decoded
+	Common::Array<QueuedFrame> _frameQueue;
+	uint _frameQueueHead;
+	uint _frameQueueCount;
+
+	const Graphics::Surface *decodeFrameIntern();
+	bool drawFrameToScreen(const Graphics::Surface *frame, int x, int y);
+	bool queueNextFrame();
+	void clearFrameQueue();
+	void freeFrameQueue();
+	bool isQueuedFrameAfterEnd() const;
+	bool hasTrackFramesLeft() const;
+
 protected:
 	// Internal helper functions
 	void stopAudio();